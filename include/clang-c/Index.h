@@ -32,7 +32,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 12
+#define CINDEX_VERSION_MINOR 13
 
 #define CINDEX_VERSION_ENCODE(major, minor) ( \
       ((major) * 10000)                       \
@@ -4561,7 +4561,22 @@ enum CXCodeComplete_Flags {
    * \brief Whether to include brief documentation within the set of code
    * completions returned.
    */
-  CXCodeComplete_IncludeBriefComments = 0x04
+  CXCodeComplete_IncludeBriefComments = 0x04,
+
+  /**
+   * \brief Whether to answer a code-completion request by filtering the
+   * results of the previous one, when only the identifier being typed at the
+   * completion point has changed.
+   *
+   * The results of such a request are kept with the translation unit, and a
+   * later request with the same options, at the same location and with the
+   * same unsaved files up to the completion location is answered without
+   * reparsing, by returning the kept results whose typed text starts with the
+   * identifier after the completion location (ignoring case), sorted by
+   * priority. The file being completed must be one of the unsaved files.
+   * No diagnostics are reported for filtered results.
+   */
+  CXCodeComplete_FilterCachedResults = 0x08
 };
 
 /**
@@ -133,11 +133,13 @@ public:
   virtual void PrintStats() {}
 
   /// \brief This callback is called for each function if the Parser was
-  /// initialized with \c SkipFunctionBodies set to \c true.
+  /// initialized with \c SkipFunctionBodies set to \c true, and for each
+  /// implicit instantiation of a function if Sema is skipping function
+  /// template instantiations.
   ///
   /// \return \c true if the function's body should be skipped. The function
-  /// body may be parsed anyway if it is needed (for instance, if it contains
-  /// the code completion point or is constexpr).
+  /// body may be parsed or instantiated anyway if it is needed (for instance,
+  /// if it contains the code completion point or is constexpr).
   virtual bool shouldSkipFunctionBody(Decl *D) { return true; }
 };
 
@@ -35,6 +35,7 @@
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/OwningPtr.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Support/Allocator.h"
 #include <vector>
@@ -138,6 +139,15 @@ class ASTContext : public RefCountedBase<ASTContext> {
   mutable llvm::DenseMap<const ObjCContainerDecl*, const ASTRecordLayout*>
     ObjCLayouts;
 
+  /// \brief A cache mapping from complete C++ class definitions to the
+  /// canonical declarations of all of their direct and indirect base classes,
+  /// sorted by address.
+  ///
+  /// This is lazily created. Only classes whose definition is complete and
+  /// not dependent are entered, so entries never need to be invalidated.
+  mutable llvm::DenseMap<const CXXRecordDecl*, ArrayRef<const CXXRecordDecl*> >
+    AllBaseClasses;
+
   /// \brief A cache from types to size and alignment information.
   typedef llvm::DenseMap<const Type*,
                          std::pair<uint64_t, unsigned> > TypeInfoMap;
@@ -161,6 +171,52 @@ class ASTContext : public RefCountedBase<ASTContext> {
   llvm::DenseMap<const FunctionDecl*, FunctionDecl*>
     ClassScopeSpecializationPattern;
 
+public:
+  /// \brief The memoized result of a call to a constexpr function.
+  struct ConstexprCallResult {
+    /// \brief The value the call evaluated to.
+    APValue Value;
+
+    /// \brief Whether the call was a constant expression, rather than merely
+    /// foldable.
+    bool IsConstantExpression;
+
+    /// \brief The number of evaluation steps the call cost, including the
+    /// cost of the calls it found in the cache.
+    uint64_t Steps;
+  };
+
+  /// \brief Table of memoized constexpr call results, keyed by the callee and
+  /// an encoding of its argument values.
+  typedef llvm::StringMap<ConstexprCallResult> ConstexprCallCacheTy;
+
+private:
+  /// \brief Memoized results of constexpr function calls with literal
+  /// arguments. Owned by the constant evaluator.
+  ConstexprCallCacheTy ConstexprCallCache;
+
+  /// \brief The number of constexpr calls answered from the call cache.
+  unsigned NumConstexprCallCacheHits;
+
+  /// \brief The number of memoizable constexpr calls that had to be
+  /// evaluated.
+  unsigned NumConstexprCallCacheMisses;
+
+  /// \brief The number of constant evaluations performed.
+  unsigned NumConstantEvaluations;
+
+  /// \brief The total number of steps taken by constant evaluation.
+  uint64_t NumConstantEvaluationSteps;
+
+  /// \brief The total number of steps that calls answered from the constexpr
+  /// call cache would have taken to evaluate again.
+  uint64_t NumConstantEvaluationCachedSteps;
+
+  /// \brief The largest cost of a single constant evaluation, counting the
+  /// steps saved by the call cache, and where that evaluation started.
+  uint64_t MaxConstantEvaluationSteps;
+  SourceLocation MaxConstantEvaluationLoc;
+
   /// \brief Representation of a "canonical" template template parameter that
   /// is used in canonical template names.
   class CanonicalTemplateTemplateParm : public llvm::FoldingSetNode {
@@ -363,6 +419,14 @@ class ASTContext : public RefCountedBase<ASTContext> {
   OwningPtr<CXXABI> ABI;
   CXXABI *createCXXABI(const TargetInfo &T);
 
+  /// \brief The mangle context shared by getMangledName() and CodeGen,
+  /// created on first use.
+  OwningPtr<MangleContext> NameMangler;
+
+  /// \brief Mangled names computed by getMangledName(). The strings are
+  /// allocated in BumpAlloc.
+  llvm::DenseMap<const NamedDecl *, StringRef> MangledNames;
+
   /// \brief The logical -> physical address space map.
   const LangAS::Map *AddrSpaceMap;
 
@@ -750,6 +814,42 @@ public:
   void PrintStats() const;
   const std::vector<Type*>& getTypes() const { return Types; }
 
+  /// \brief Print a breakdown of the memory used by AST nodes, by node kind
+  /// and by whether the node came from the main file, a header or a template
+  /// instantiation.
+  ///
+  /// \param JSON If true, print the breakdown as a JSON object.
+  void PrintMemoryStats(raw_ostream &OS, bool JSON = false) const;
+
+  /// \brief Retrieve the table of memoized constexpr call results.
+  ConstexprCallCacheTy &getConstexprCallCache() { return ConstexprCallCache; }
+
+  /// \brief Note that a constexpr call was answered from the call cache.
+  void noteConstexprCallCacheHit() { ++NumConstexprCallCacheHits; }
+
+  /// \brief Note that a memoizable constexpr call had to be evaluated.
+  void noteConstexprCallCacheMiss() { ++NumConstexprCallCacheMisses; }
+
+  /// \brief The number of constexpr calls answered from the call cache.
+  unsigned getNumConstexprCallCacheHits() const {
+    return NumConstexprCallCacheHits;
+  }
+
+  /// \brief The number of memoizable constexpr calls that had to be
+  /// evaluated.
+  unsigned getNumConstexprCallCacheMisses() const {
+    return NumConstexprCallCacheMisses;
+  }
+
+  /// \brief Record the cost of a top-level constant evaluation.
+  ///
+  /// \param Steps The number of steps the evaluation took.
+  /// \param CachedSteps The number of further steps that the calls it found
+  /// in the constexpr call cache took when they were first evaluated.
+  /// \param Loc Where the evaluation started.
+  void noteConstantEvaluation(uint64_t Steps, uint64_t CachedSteps,
+                              SourceLocation Loc);
+
   /// \brief Retrieve the declaration for the 128-bit signed integer type.
   TypedefDecl *getInt128Decl() const;
 
@@ -1540,6 +1640,13 @@ public:
   /// position information.
   const ASTRecordLayout &getASTRecordLayout(const RecordDecl *D) const;
 
+  /// \brief Whether laying out a record can produce a diagnostic, because
+  /// -Wpadded or -Wpacked is enabled somewhere in the translation unit.
+  ///
+  /// Layouts stored in an AST file are only used when it cannot, so that
+  /// records from the AST file are still diagnosed.
+  bool mayDiagnoseRecordLayout() const;
+
   /// \brief Get or compute information about the layout of the specified
   /// Objective-C interface.
   const ASTRecordLayout &getASTObjCInterfaceLayout(const ObjCInterfaceDecl *D)
@@ -1548,6 +1655,15 @@ public:
   void DumpRecordLayout(const RecordDecl *RD, raw_ostream &OS,
                         bool Simple = false) const;
 
+  /// \brief Get or compute the set of all direct and indirect base classes of
+  /// the given C++ class, as canonical declarations sorted by address.
+  ///
+  /// \returns false if the class is incomplete, dependent or invalid, or has
+  /// such a base, in which case the bases must be found by walking the
+  /// hierarchy.
+  bool getAllBaseClasses(const CXXRecordDecl *RD,
+                         ArrayRef<const CXXRecordDecl*> &Bases) const;
+
   /// \brief Get or compute information about the layout of the specified
   /// Objective-C implementation.
   ///
@@ -1583,6 +1699,22 @@ public:
   bool isNearlyEmpty(const CXXRecordDecl *RD) const;
 
   MangleContext *createMangleContext();
+
+  /// \brief Retrieve the mangle context for the target's C++ ABI that is
+  /// shared by all clients of this ASTContext.
+  ///
+  /// Local entities are numbered as they are mangled, so clients that want
+  /// the names CodeGen emits must use this context rather than their own.
+  MangleContext &getMangleContext();
+
+  /// \brief Retrieve the name of the given function or variable as it
+  /// would be emitted in the object file under the target's C++ ABI.
+  ///
+  /// The name is computed once per declaration and shared by all callers,
+  /// including CodeGen; the returned string lives as long as the
+  /// ASTContext. Constructors and destructors are mangled as their
+  /// complete-object variants.
+  StringRef getMangledName(const NamedDecl *D);
   
   void DeepCollectObjCIvars(const ObjCInterfaceDecl *OI, bool leafClass,
                             SmallVectorImpl<const ObjCIvarDecl*> &Ivars) const;
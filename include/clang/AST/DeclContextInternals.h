@@ -136,6 +136,11 @@ public:
     return DeclContext::lookup_result(Vector.begin(), Vector.end());
   }
 
+  /// isFirstFunctionDeclaration - Returns true if D is the first declaration
+  /// of a function or function template. A function only ever replaces its
+  /// previous declaration, so D cannot replace anything in the list.
+  static bool isFirstFunctionDeclaration(const NamedDecl *D);
+
   /// HandleRedeclaration - If this is a redeclaration of an existing decl,
   /// replace the old one with D and return true.  Otherwise return false.
   bool HandleRedeclaration(NamedDecl *D) {
@@ -147,6 +152,11 @@ public:
       return true;
     }
 
+    // A new overload need not be compared against every member of a
+    // (possibly very large) overload set.
+    if (isFirstFunctionDeclaration(D))
+      return false;
+
     // Determine if this declaration is actually a redeclaration.
     DeclsTy &Vec = *getAsVector();
     for (DeclsTy::iterator OD = Vec.begin(), ODEnd = Vec.end();
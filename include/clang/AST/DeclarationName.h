@@ -502,6 +502,10 @@ public:
     LocInfo.CXXLiteralOperatorName.OpNameLoc = Loc.getRawEncoding();
   }
 
+  /// \brief Determine whether this kind of name carries source or type
+  /// location info beyond the main name location.
+  bool hasLocInfo() const;
+
   /// \brief Determine whether this name involves a template parameter.
   bool isInstantiationDependent() const;
   
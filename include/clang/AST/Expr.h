@@ -851,6 +851,11 @@ public:
 ///   DeclRefExprBits.RefersToEnclosingLocal
 ///       Specifies when this declaration reference expression (validly)
 ///       refers to a local variable from a different function.
+///   DeclRefExprBits.HasNameLoc:
+///       Specifies when this declaration reference expression stores
+///       source/type location info for an operator, literal operator,
+///       constructor, destructor or conversion function name. It is laid
+///       out before the other optional constructs.
 class DeclRefExpr : public Expr {
   /// \brief The declaration that we are referencing.
   ValueDecl *D;
@@ -858,14 +863,33 @@ class DeclRefExpr : public Expr {
   /// \brief The location of the declaration name itself.
   SourceLocation Loc;
 
-  /// \brief Provides source/type location info for the declaration name
-  /// embedded in D.
-  DeclarationNameLoc DNLoc;
+  /// \brief Determine whether source/type location info for the declaration
+  /// name is attached to the end of this DRE.
+  bool hasNameLoc() const { return DeclRefExprBits.HasNameLoc; }
+
+  /// \brief Helper to retrieve the optional DeclarationNameLoc.
+  DeclarationNameLoc &getInternalNameLoc() {
+    assert(hasNameLoc());
+    return *reinterpret_cast<DeclarationNameLoc *>(this + 1);
+  }
+
+  /// \brief Helper to retrieve the optional DeclarationNameLoc.
+  const DeclarationNameLoc &getInternalNameLoc() const {
+    return const_cast<DeclRefExpr *>(this)->getInternalNameLoc();
+  }
+
+  /// \brief Retrieve the start of the optional constructs that follow the
+  /// DeclarationNameLoc.
+  void *getTrailingStorage() {
+    if (hasNameLoc())
+      return &getInternalNameLoc() + 1;
+    return this + 1;
+  }
 
   /// \brief Helper to retrieve the optional NestedNameSpecifierLoc.
   NestedNameSpecifierLoc &getInternalQualifierLoc() {
     assert(hasQualifier());
-    return *reinterpret_cast<NestedNameSpecifierLoc *>(this + 1);
+    return *reinterpret_cast<NestedNameSpecifierLoc *>(getTrailingStorage());
   }
 
   /// \brief Helper to retrieve the optional NestedNameSpecifierLoc.
@@ -883,7 +907,7 @@ class DeclRefExpr : public Expr {
     assert(hasFoundDecl());
     if (hasQualifier())
       return *reinterpret_cast<NamedDecl **>(&getInternalQualifierLoc() + 1);
-    return *reinterpret_cast<NamedDecl **>(this + 1);
+    return *reinterpret_cast<NamedDecl **>(getTrailingStorage());
   }
 
   /// \brief Helper to retrieve the optional NamedDecl through which this
@@ -910,16 +934,21 @@ class DeclRefExpr : public Expr {
   void computeDependence(ASTContext &C);
 
 public:
+  // NOTE: this constructor should be used only when it is known that
+  // the declaration name can not provide additional syntactic info
+  // (i.e., source locations for C++ operator names or type source info
+  // for constructors, destructors and conversion operators). Use Create()
+  // otherwise.
   DeclRefExpr(ValueDecl *D, bool refersToEnclosingLocal, QualType T,
-              ExprValueKind VK, SourceLocation L,
-              const DeclarationNameLoc &LocInfo = DeclarationNameLoc())
+              ExprValueKind VK, SourceLocation L)
     : Expr(DeclRefExprClass, T, VK, OK_Ordinary, false, false, false, false),
-      D(D), Loc(L), DNLoc(LocInfo) {
+      D(D), Loc(L) {
     DeclRefExprBits.HasQualifier = 0;
     DeclRefExprBits.HasTemplateKWAndArgsInfo = 0;
     DeclRefExprBits.HasFoundDecl = 0;
     DeclRefExprBits.HadMultipleCandidates = 0;
     DeclRefExprBits.RefersToEnclosingLocal = refersToEnclosingLocal;
+    DeclRefExprBits.HasNameLoc = 0;
     computeDependence(D->getASTContext());
   }
 
@@ -945,6 +974,7 @@ public:
 
   /// \brief Construct an empty declaration reference expression.
   static DeclRefExpr *CreateEmpty(ASTContext &Context,
+                                  bool HasNameLoc,
                                   bool HasQualifier,
                                   bool HasFoundDecl,
                                   bool HasTemplateKWAndArgsInfo,
@@ -955,7 +985,11 @@ public:
   void setDecl(ValueDecl *NewD) { D = NewD; }
 
   DeclarationNameInfo getNameInfo() const {
-    return DeclarationNameInfo(getDecl()->getDeclName(), Loc, DNLoc);
+    if (!hasNameLoc())
+      return DeclarationNameInfo(getDecl()->getDeclName(), Loc,
+                                 DeclarationNameLoc());
+    return DeclarationNameInfo(getDecl()->getDeclName(), Loc,
+                               getInternalNameLoc());
   }
 
   SourceLocation getLocation() const { return Loc; }
@@ -1017,7 +1051,7 @@ public:
       return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(
         &getInternalQualifierLoc() + 1);
 
-    return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(this + 1);
+    return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(getTrailingStorage());
   }
 
   /// \brief Return the optional template keyword and arguments info.
@@ -2273,39 +2307,57 @@ class MemberExpr : public Expr {
   /// In X.F, this is the decl referenced by F.
   ValueDecl *MemberDecl;
 
-  /// MemberDNLoc - Provides source/type location info for the
-  /// declaration name embedded in MemberDecl.
-  DeclarationNameLoc MemberDNLoc;
-
   /// MemberLoc - This is the location of the member name.
   SourceLocation MemberLoc;
 
-  /// IsArrow - True if this is "X->F", false if this is "X.F".
-  bool IsArrow : 1;
-
-  /// \brief True if this member expression used a nested-name-specifier to
-  /// refer to the member, e.g., "x->Base::f", or found its member via a using
-  /// declaration.  When true, a MemberNameQualifier
-  /// structure is allocated immediately after the MemberExpr.
-  bool HasQualifierOrFoundDecl : 1;
-
-  /// \brief True if this member expression specified a template keyword
-  /// and/or a template argument list explicitly, e.g., x->f<int>,
-  /// x->template f, x->template f<int>.
-  /// When true, an ASTTemplateKWAndArgsInfo structure and its
-  /// TemplateArguments (if any) are allocated immediately after
-  /// the MemberExpr or, if the member expression also has a qualifier,
-  /// after the MemberNameQualifier structure.
-  bool HasTemplateKWAndArgsInfo : 1;
-
-  /// \brief True if this member expression refers to a method that
-  /// was resolved from an overloaded set having size greater than 1.
-  bool HadMultipleCandidates : 1;
+  // The following flags live in MemberExprBits:
+  //
+  //   IsArrow - True if this is "X->F", false if this is "X.F".
+  //
+  //   HasNameLoc - True if source/type location info for the member name
+  //   (a DeclarationNameLoc) is allocated immediately after the MemberExpr.
+  //   This is only the case for operator, literal operator, constructor,
+  //   destructor and conversion function names.
+  //
+  //   HasQualifierOrFoundDecl - True if this member expression used a
+  //   nested-name-specifier to refer to the member, e.g., "x->Base::f", or
+  //   found its member via a using declaration.  When true, a
+  //   MemberNameQualifier structure is allocated after the MemberExpr and
+  //   its DeclarationNameLoc, if any.
+  //
+  //   HasTemplateKWAndArgsInfo - True if this member expression specified a
+  //   template keyword and/or a template argument list explicitly, e.g.,
+  //   x->f<int>, x->template f, x->template f<int>.  When true, an
+  //   ASTTemplateKWAndArgsInfo structure and its TemplateArguments (if any)
+  //   are allocated after the other optional structures.
+  //
+  //   HadMultipleCandidates - True if this member expression refers to a
+  //   method that was resolved from an overloaded set having size greater
+  //   than 1.
+
+  /// \brief Retrieve the source/type location info for the member name.
+  DeclarationNameLoc &getInternalNameLoc() {
+    assert(MemberExprBits.HasNameLoc);
+    return *reinterpret_cast<DeclarationNameLoc *>(this + 1);
+  }
+
+  /// \brief Retrieve the source/type location info for the member name.
+  const DeclarationNameLoc &getInternalNameLoc() const {
+    return const_cast<MemberExpr *>(this)->getInternalNameLoc();
+  }
+
+  /// \brief Retrieve the start of the optional structures that follow the
+  /// DeclarationNameLoc.
+  void *getTrailingStorage() {
+    if (MemberExprBits.HasNameLoc)
+      return &getInternalNameLoc() + 1;
+    return this + 1;
+  }
 
   /// \brief Retrieve the qualifier that preceded the member name, if any.
   MemberNameQualifier *getMemberQualifier() {
-    assert(HasQualifierOrFoundDecl);
-    return reinterpret_cast<MemberNameQualifier *> (this + 1);
+    assert(MemberExprBits.HasQualifierOrFoundDecl);
+    return reinterpret_cast<MemberNameQualifier *>(getTrailingStorage());
   }
 
   /// \brief Retrieve the qualifier that preceded the member name, if any.
@@ -2313,7 +2365,8 @@ class MemberExpr : public Expr {
     return const_cast<MemberExpr *>(this)->getMemberQualifier();
   }
 
-public:
+  // NOTE: the caller must have allocated room for the DeclarationNameLoc
+  // after the MemberExpr if NameInfo.hasLocInfo().
   MemberExpr(Expr *base, bool isarrow, ValueDecl *memberdecl,
              const DeclarationNameInfo &NameInfo, QualType ty,
              ExprValueKind VK, ExprObjectKind OK)
@@ -2322,13 +2375,18 @@ public:
            base->isValueDependent(),
            base->isInstantiationDependent(),
            base->containsUnexpandedParameterPack()),
-      Base(base), MemberDecl(memberdecl), MemberDNLoc(NameInfo.getInfo()),
-      MemberLoc(NameInfo.getLoc()), IsArrow(isarrow),
-      HasQualifierOrFoundDecl(false), HasTemplateKWAndArgsInfo(false),
-      HadMultipleCandidates(false) {
+      Base(base), MemberDecl(memberdecl), MemberLoc(NameInfo.getLoc()) {
     assert(memberdecl->getDeclName() == NameInfo.getName());
+    MemberExprBits.IsArrow = isarrow;
+    MemberExprBits.HasQualifierOrFoundDecl = false;
+    MemberExprBits.HasTemplateKWAndArgsInfo = false;
+    MemberExprBits.HadMultipleCandidates = false;
+    MemberExprBits.HasNameLoc = NameInfo.hasLocInfo();
+    if (NameInfo.hasLocInfo())
+      getInternalNameLoc() = NameInfo.getInfo();
   }
 
+public:
   // NOTE: this constructor should be used only when it is known that
   // the member name can not provide additional syntactic info
   // (i.e., source locations for C++ operator names or type source info
@@ -2340,10 +2398,13 @@ public:
            base->isTypeDependent(), base->isValueDependent(),
            base->isInstantiationDependent(),
            base->containsUnexpandedParameterPack()),
-      Base(base), MemberDecl(memberdecl), MemberDNLoc(), MemberLoc(l),
-      IsArrow(isarrow),
-      HasQualifierOrFoundDecl(false), HasTemplateKWAndArgsInfo(false),
-      HadMultipleCandidates(false) {}
+      Base(base), MemberDecl(memberdecl), MemberLoc(l) {
+    MemberExprBits.IsArrow = isarrow;
+    MemberExprBits.HasQualifierOrFoundDecl = false;
+    MemberExprBits.HasTemplateKWAndArgsInfo = false;
+    MemberExprBits.HadMultipleCandidates = false;
+    MemberExprBits.HasNameLoc = false;
+  }
 
   static MemberExpr *Create(ASTContext &C, Expr *base, bool isarrow,
                             NestedNameSpecifierLoc QualifierLoc,
@@ -2365,7 +2426,7 @@ public:
 
   /// \brief Retrieves the declaration found by lookup.
   DeclAccessPair getFoundDecl() const {
-    if (!HasQualifierOrFoundDecl)
+    if (!MemberExprBits.HasQualifierOrFoundDecl)
       return DeclAccessPair::make(getMemberDecl(),
                                   getMemberDecl()->getAccess());
     return getMemberQualifier()->FoundDecl;
@@ -2380,7 +2441,7 @@ public:
   /// nested-name-specifier that precedes the member name. Otherwise, returns
   /// NULL.
   NestedNameSpecifier *getQualifier() const {
-    if (!HasQualifierOrFoundDecl)
+    if (!MemberExprBits.HasQualifierOrFoundDecl)
       return 0;
 
     return getMemberQualifier()->QualifierLoc.getNestedNameSpecifier();
@@ -2398,11 +2459,12 @@ public:
 
   /// \brief Return the optional template keyword and arguments info.
   ASTTemplateKWAndArgsInfo *getTemplateKWAndArgsInfo() {
-    if (!HasTemplateKWAndArgsInfo)
+    if (!MemberExprBits.HasTemplateKWAndArgsInfo)
       return 0;
 
-    if (!HasQualifierOrFoundDecl)
-      return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(this + 1);
+    if (!MemberExprBits.HasQualifierOrFoundDecl)
+      return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(
+                                                      getTrailingStorage());
 
     return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(
                                                       getMemberQualifier() + 1);
@@ -2416,21 +2478,21 @@ public:
   /// \brief Retrieve the location of the template keyword preceding
   /// the member name, if any.
   SourceLocation getTemplateKeywordLoc() const {
-    if (!HasTemplateKWAndArgsInfo) return SourceLocation();
+    if (!MemberExprBits.HasTemplateKWAndArgsInfo) return SourceLocation();
     return getTemplateKWAndArgsInfo()->getTemplateKeywordLoc();
   }
 
   /// \brief Retrieve the location of the left angle bracket starting the
   /// explicit template argument list following the member name, if any.
   SourceLocation getLAngleLoc() const {
-    if (!HasTemplateKWAndArgsInfo) return SourceLocation();
+    if (!MemberExprBits.HasTemplateKWAndArgsInfo) return SourceLocation();
     return getTemplateKWAndArgsInfo()->LAngleLoc;
   }
 
   /// \brief Retrieve the location of the right angle bracket ending the
   /// explicit template argument list following the member name, if any.
   SourceLocation getRAngleLoc() const {
-    if (!HasTemplateKWAndArgsInfo) return SourceLocation();
+    if (!MemberExprBits.HasTemplateKWAndArgsInfo) return SourceLocation();
     return getTemplateKWAndArgsInfo()->RAngleLoc;
   }
 
@@ -2491,12 +2553,15 @@ public:
 
   /// \brief Retrieve the member declaration name info.
   DeclarationNameInfo getMemberNameInfo() const {
-    return DeclarationNameInfo(MemberDecl->getDeclName(),
-                               MemberLoc, MemberDNLoc);
+    if (!MemberExprBits.HasNameLoc)
+      return DeclarationNameInfo(MemberDecl->getDeclName(), MemberLoc,
+                                 DeclarationNameLoc());
+    return DeclarationNameInfo(MemberDecl->getDeclName(), MemberLoc,
+                               getInternalNameLoc());
   }
 
-  bool isArrow() const { return IsArrow; }
-  void setArrow(bool A) { IsArrow = A; }
+  bool isArrow() const { return MemberExprBits.IsArrow; }
+  void setArrow(bool A) { MemberExprBits.IsArrow = A; }
 
   /// getMemberLoc - Return the location of the "member", in X->F, it is the
   /// location of 'F'.
@@ -2516,13 +2581,13 @@ public:
   /// \brief Returns true if this member expression refers to a method that
   /// was resolved from an overloaded set having size greater than 1.
   bool hadMultipleCandidates() const {
-    return HadMultipleCandidates;
+    return MemberExprBits.HadMultipleCandidates;
   }
   /// \brief Sets the flag telling whether this expression refers to
   /// a method that was resolved from an overloaded set having size
   /// greater than 1.
   void setHadMultipleCandidates(bool V = true) {
-    HadMultipleCandidates = V;
+    MemberExprBits.HadMultipleCandidates = V;
   }
 
   static bool classof(const Stmt *T) {
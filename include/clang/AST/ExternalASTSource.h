@@ -21,6 +21,7 @@
 namespace clang {
 
 class ASTConsumer;
+class ASTRecordLayout;
 class CXXBaseSpecifier;
 class DeclarationName;
 class ExternalSemaSource; // layering violation required for downcasting
@@ -252,6 +253,19 @@ public:
   { 
     return false;
   }
+
+  /// \brief Retrieve the complete layout that was stored for the given
+  /// record, if any.
+  ///
+  /// Unlike \c layoutRecordType, the returned layout is used as-is: the
+  /// record is not laid out again. The layout must be allocated in the
+  /// ASTContext.
+  ///
+  /// The default implementation of this method returns null.
+  virtual const ASTRecordLayout *getStoredRecordLayout(const RecordDecl *Record)
+  {
+    return 0;
+  }
   
   //===--------------------------------------------------------------------===//
   // Queries for performance analysis.
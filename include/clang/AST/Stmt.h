@@ -209,6 +209,18 @@ protected:
     unsigned HasFoundDecl : 1;
     unsigned HadMultipleCandidates : 1;
     unsigned RefersToEnclosingLocal : 1;
+    unsigned HasNameLoc : 1;
+  };
+
+  class MemberExprBitfields {
+    friend class MemberExpr;
+    unsigned : NumExprBits;
+
+    unsigned IsArrow : 1;
+    unsigned HasQualifierOrFoundDecl : 1;
+    unsigned HasTemplateKWAndArgsInfo : 1;
+    unsigned HadMultipleCandidates : 1;
+    unsigned HasNameLoc : 1;
   };
 
   class CastExprBitfields {
@@ -297,6 +309,7 @@ protected:
     FloatingLiteralBitfields FloatingLiteralBits;
     UnaryExprOrTypeTraitExprBitfields UnaryExprOrTypeTraitExprBits;
     DeclRefExprBitfields DeclRefExprBits;
+    MemberExprBitfields MemberExprBits;
     CastExprBitfields CastExprBits;
     CallExprBitfields CallExprBits;
     ExprWithCleanupsBitfields ExprWithCleanupsBits;
@@ -18,6 +18,7 @@
 
 #include "clang/Basic/LLVM.h"
 #include <cstring>
+#include <vector>
 
 // VC++ defines 'alloca' as an object-like macro, which interferes with our
 // builtins.
@@ -62,17 +63,38 @@ struct Info {
 class Context {
   const Info *TSRecords;
   unsigned NumTSRecords;
+
+  /// \brief Open-addressed hash table mapping the names of the builtins that
+  /// are available in the current language to their IDs; empty slots are 0.
+  ///
+  /// Builtin identifiers are not entered into the identifier table up front.
+  /// Instead, the table asks us for the builtin ID of each identifier when it
+  /// is first created, so startup cost doesn't grow with the number of
+  /// builtins the target supports.
+  std::vector<unsigned short> NameTable;
+
 public:
   Context();
 
   /// \brief Perform target-specific initialization
   void InitializeTarget(const TargetInfo &Target);
   
-  /// \brief Mark the identifiers for all the builtins with their
-  /// appropriate builtin ID # and mark any non-portable builtin identifiers as
-  /// such.
+  /// \brief Arrange for identifiers naming builtins to be marked with their
+  /// appropriate builtin ID #, taking into account which builtins are
+  /// available with \p LangOpts.
+  ///
+  /// Identifiers already in \p Table are marked immediately; identifiers
+  /// created later are marked by the table as they are created.
   void InitializeBuiltins(IdentifierTable &Table, const LangOptions& LangOpts);
 
+  /// \brief Return the ID of the builtin with the given name, or 0 if there is
+  /// no such builtin in the current language.
+  unsigned lookupBuiltinID(StringRef Name) const;
+
+  /// \brief Populate the vector with the names of the builtins that are
+  /// available in the current language.
+  void GetAvailableBuiltinNames(SmallVectorImpl<const char *> &Names) const;
+
   /// \brief Popular the vector with the names of all of the builtins.
   void GetBuiltinNames(SmallVectorImpl<const char *> &Names,
                        bool NoBuiltins);
@@ -163,6 +185,9 @@ public:
 
 private:
   const Info &GetRecord(unsigned ID) const;
+
+  /// \brief Add a builtin to \c NameTable.
+  void addBuiltinName(StringRef Name, unsigned ID);
 };
 
 }
@@ -19,6 +19,7 @@
 #include "clang/Basic/DiagnosticOptions.h"
 #include "clang/Basic/SourceLocation.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/OwningPtr.h"
@@ -276,6 +277,34 @@ private:
   /// the given source location.
   DiagStatePointsTy::iterator GetDiagStatePointForLoc(SourceLocation Loc) const;
 
+  /// \brief Bit set for each builtin diagnostic whose entry in
+  /// \c IgnoredEverywhere is up to date.
+  mutable llvm::BitVector IgnoredEverywhereComputed;
+
+  /// \brief Bit set for each builtin diagnostic that maps to "ignored" in
+  /// every DiagState, i.e. at every location of the translation unit.
+  ///
+  /// Both bit vectors are filled lazily by \c isIgnoredEverywhere. A mapping
+  /// change only affects the bit of the remapped diagnostic; changing a
+  /// global flag that can upgrade an ignored diagnostic affects all of them.
+  mutable llvm::BitVector IgnoredEverywhere;
+
+  /// \brief Forget everything we know about diagnostics that are ignored
+  /// everywhere; called when a global flag changes.
+  void invalidateIgnoredEverywhere() { IgnoredEverywhereComputed.reset(); }
+
+  /// \brief Forget whether \p Diag is ignored everywhere; called when its
+  /// mapping changes in an existing DiagState.
+  void invalidateIgnoredEverywhere(diag::kind Diag) {
+    if (Diag < IgnoredEverywhereComputed.size())
+      IgnoredEverywhereComputed.reset(Diag);
+  }
+
+  /// \brief Update whether \p Diag is ignored everywhere after a new
+  /// DiagState mapping it to \p Info was added.
+  void noteIgnoredEverywhereNewState(diag::kind Diag,
+                                     DiagnosticMappingInfo Info);
+
   /// \brief Sticky flag set to \c true when an error is emitted.
   bool ErrorOccurred;
 
@@ -427,14 +456,22 @@ public:
   /// \brief When set to true, any unmapped warnings are ignored.
   ///
   /// If this and WarningsAsErrors are both set, then this one wins.
-  void setIgnoreAllWarnings(bool Val) { IgnoreAllWarnings = Val; }
+  void setIgnoreAllWarnings(bool Val) {
+    if (IgnoreAllWarnings != Val)
+      invalidateIgnoredEverywhere();
+    IgnoreAllWarnings = Val;
+  }
   bool getIgnoreAllWarnings() const { return IgnoreAllWarnings; }
 
   /// \brief When set to true, any unmapped ignored warnings are no longer
   /// ignored.
   ///
   /// If this and IgnoreAllWarnings are both set, then that one wins.
-  void setEnableAllWarnings(bool Val) { EnableAllWarnings = Val; }
+  void setEnableAllWarnings(bool Val) {
+    if (EnableAllWarnings != Val)
+      invalidateIgnoredEverywhere();
+    EnableAllWarnings = Val;
+  }
   bool getEnableAllWarnngs() const { return EnableAllWarnings; }
   
   /// \brief When set to true, any warnings reported are issued as errors.
@@ -496,6 +533,8 @@ public:
   ///
   /// This corresponds to the GCC -pedantic and -pedantic-errors option.
   void setExtensionHandlingBehavior(ExtensionHandling H) {
+    if (ExtBehavior != H)
+      invalidateIgnoredEverywhere();
     ExtBehavior = H;
   }
   ExtensionHandling getExtensionHandlingBehavior() const { return ExtBehavior; }
@@ -631,6 +670,17 @@ public:
     return (Level)Diags->getDiagnosticLevel(DiagID, Loc, *this);
   }
 
+  /// \brief Determine whether the given diagnostic is ignored at every
+  /// source location of the translation unit.
+  ///
+  /// This is a cheap, bitset-backed query that clients can use to skip work
+  /// that is only needed to produce a warning that nobody enabled. Unlike
+  /// \c getDiagnosticLevel, it doesn't look up the diagnostic state for a
+  /// particular location; when diagnostic pragmas enable the warning
+  /// somewhere it conservatively returns \c false and the caller should fall
+  /// back to \c getDiagnosticLevel.
+  bool isIgnoredEverywhere(unsigned DiagID) const;
+
   /// \brief Issue the message to the client.
   ///
   /// This actually returns an instance of DiagnosticBuilder which emits the
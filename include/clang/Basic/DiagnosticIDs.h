@@ -252,6 +252,16 @@ private:
   DiagnosticIDs::Level getDiagnosticLevel(unsigned DiagID, SourceLocation Loc,
                                           const DiagnosticsEngine &Diag) const;
 
+  /// \brief Determine whether the given builtin diagnostic maps to
+  /// "ignored" in every diagnostic state of \p Diag, regardless of location.
+  bool isIgnoredInAllStates(unsigned DiagID,
+                            const DiagnosticsEngine &Diag) const;
+
+  /// \brief Determine whether the given builtin diagnostic is ignored in a
+  /// diagnostic state that maps it to \p MappingInfo.
+  bool isIgnoredMapping(unsigned DiagID, DiagnosticMappingInfo MappingInfo,
+                        const DiagnosticsEngine &Diag) const;
+
   /// \brief An internal implementation helper used when \p DiagClass is
   /// already known.
   DiagnosticIDs::Level getDiagnosticLevel(unsigned DiagID,
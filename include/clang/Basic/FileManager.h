@@ -166,6 +166,7 @@ class FileManager : public RefCountedBase<FileManager> {
   // Statistics.
   unsigned NumDirLookups, NumFileLookups;
   unsigned NumDirCacheMisses, NumFileCacheMisses;
+  unsigned NumFilesPrefetched;
 
   // Caching.
   OwningPtr<FileSystemStatCache> StatCache;
@@ -240,6 +241,14 @@ public:
   llvm::MemoryBuffer *getBufferForFile(StringRef Filename,
                                        std::string *ErrorStr = 0);
 
+  /// \brief Hint that the contents of \p Entry will be read soon.
+  ///
+  /// Where the operating system supports it, this asks it to start reading
+  /// the file into the page cache in the background, so that a later call to
+  /// getBufferForFile() doesn't have to wait for the disk or the network.
+  /// Failures are ignored; this is only a hint.
+  void prefetchFile(const FileEntry *Entry);
+
   /// \brief Get the 'stat' information for the given \p Path.
   ///
   /// If the path is relative, it will be resolved against the WorkingDir of the
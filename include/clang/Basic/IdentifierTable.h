@@ -24,6 +24,7 @@
 #include "llvm/Support/PointerLikeTypeTraits.h"
 #include <cassert>
 #include <string>
+#include <vector>
 
 namespace llvm {
   template <typename T> struct DenseMapInfo;
@@ -36,6 +37,7 @@ namespace clang {
   class SourceLocation;
   class MultiKeywordSelector; // private class used by Selector
   class DeclarationName;      // AST class that stores declaration names
+  namespace Builtin { class Context; }
 
   /// \brief A simple pair of identifier info and location.
   typedef std::pair<IdentifierInfo*, SourceLocation> IdentifierLocPair;
@@ -398,6 +400,11 @@ public:
   /// \returns A new iterator into the set of known identifiers. The
   /// caller is responsible for deleting this iterator.
   virtual IdentifierIterator *getIdentifiers() const;
+
+  /// \brief Retrieve a number that changes whenever identifiers may have
+  /// been added to the set that getIdentifiers() walks, e.g. because a
+  /// module was loaded.
+  virtual unsigned getGeneration() const { return 0; }
 };
 
 /// \brief An abstract class used to resolve numerical identifier
@@ -426,6 +433,23 @@ class IdentifierTable {
 
   IdentifierInfoLookup* ExternalLookup;
 
+  /// \brief The builtins used to mark newly-created identifiers with their
+  /// builtin ID, or null if builtins have not been initialized.
+  const Builtin::Context *Builtins;
+
+  /// \brief Mark a newly-created identifier with its builtin ID, if it names
+  /// a builtin.
+  void initializeBuiltinID(IdentifierInfo &II);
+
+  /// \brief If non-null, the names of the identifiers added to the table are
+  /// appended here.
+  std::vector<StringRef> *NewNames;
+
+  void noteNewIdentifier(const llvm::StringMapEntry<IdentifierInfo*> &Entry) {
+    if (NewNames)
+      NewNames->push_back(Entry.getKey());
+  }
+
 public:
   /// \brief Create the identifier table, populating it with info about the
   /// language keywords for the language specified by \p LangOpts.
@@ -441,6 +465,22 @@ public:
   IdentifierInfoLookup *getExternalIdentifierLookup() const {
     return ExternalLookup;
   }
+
+  /// \brief Use \p Context to mark identifiers that name builtins with their
+  /// builtin ID, both those already in the table and those created later.
+  ///
+  /// Identifiers loaded from an AST file keep the builtin ID they were
+  /// stored with.
+  void setBuiltinContext(const Builtin::Context *Context);
+
+  /// \brief Append the name of each identifier added to the table from now
+  /// on to \p Names, or stop doing so if \p Names is null.
+  ///
+  /// This lets clients that index the names in the table keep their index
+  /// up to date without walking the whole table again.
+  void setNewIdentifierNames(std::vector<StringRef> *Names) {
+    NewNames = Names;
+  }
   
   llvm::BumpPtrAllocator& getAllocator() {
     return HashTable.getAllocator();
@@ -461,6 +501,9 @@ public:
       if (II) {
         // Cache in the StringMap for subsequent lookups.
         Entry.setValue(II);
+        if (Builtins && !II->isFromAST())
+          initializeBuiltinID(*II);
+        noteNewIdentifier(Entry);
         return *II;
       }
     }
@@ -474,6 +517,10 @@ public:
     // contents.
     II->Entry = &Entry;
 
+    if (Builtins)
+      initializeBuiltinID(*II);
+    noteNewIdentifier(Entry);
+
     return *II;
   }
 
@@ -509,6 +556,7 @@ public:
       // If this is the 'import' contextual keyword, mark it as such.
       if (Name.equals("import"))
         II->setModulesImport(true);
+      noteNewIdentifier(Entry);
     }
 
     return *II;
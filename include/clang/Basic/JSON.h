@@ -0,0 +1,28 @@
+//===--- JSON.h - Helpers for writing JSON ----------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Defines helpers shared by the parts of clang that write JSON.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_BASIC_JSON_H
+#define LLVM_CLANG_BASIC_JSON_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace clang {
+
+/// \brief Write \p Str to \p OS as a JSON string literal, quotes included.
+void writeJSONString(raw_ostream &OS, StringRef Str);
+
+} // end namespace clang
+
+#endif
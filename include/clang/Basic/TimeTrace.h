@@ -0,0 +1,134 @@
+//===--- TimeTrace.h - Hierarchical trace of compile time -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Defines TimeTrace and TimeTraceScope, which record the time spent
+/// in the major phases of a compilation for -ftime-trace.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_BASIC_TIMETRACE_H
+#define LLVM_CLANG_BASIC_TIMETRACE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/DataTypes.h"
+#include <string>
+#include <vector>
+
+namespace clang {
+
+/// \brief A trace of the time spent in nested regions of a compilation.
+///
+/// Regions are marked with TimeTraceScope objects, which record an event in
+/// the trace that is active on the current thread, if any. Clients that
+/// measure regions themselves can add events directly. The trace can be
+/// written in the Chrome trace event format, to be viewed in
+/// chrome://tracing or a compatible viewer.
+class TimeTrace {
+public:
+  /// \brief A region of the trace.
+  struct Event {
+    /// \brief What the region does, e.g. "ParseTopLevelDecl".
+    std::string Name;
+
+    /// \brief The kind of region, if any.
+    std::string Category;
+
+    /// \brief When the region started, as returned by getCurrentTime().
+    double Start;
+
+    /// \brief How long the region lasted, in seconds.
+    double Duration;
+
+    /// \brief Arguments of the event with string values, e.g. the
+    /// declaration the region operates on.
+    std::vector<std::pair<std::string, std::string> > Args;
+
+    /// \brief Arguments of the event with numeric values.
+    std::vector<std::pair<std::string, uint64_t> > Counts;
+
+    Event() : Start(0), Duration(0) {}
+  };
+
+private:
+  double Epoch;
+  SmallVector<double, 16> Starts;
+  std::vector<Event> Events;
+
+public:
+  TimeTrace();
+  ~TimeTrace();
+
+  /// \brief The current wall time in seconds, for measuring regions.
+  static double getCurrentTime();
+
+  /// \brief The trace being recorded on the current thread, or null.
+  static TimeTrace *getActive();
+
+  /// \brief Record the events on the current thread in \p Trace, or stop
+  /// recording them if \p Trace is null.
+  static void setActive(TimeTrace *Trace);
+
+  /// \brief Note that a region starts now.
+  void begin();
+
+  /// \brief Note that the innermost region that has not ended yet ends now.
+  ///
+  /// \param Name What the region does, e.g. "ParseTopLevelDecl".
+  /// \param Detail What it operates on, e.g. the name of a declaration.
+  void end(StringRef Name, StringRef Detail);
+
+  /// \brief Add an event for a region that was measured by the caller.
+  void addEvent(const Event &E) { Events.push_back(E); }
+
+  /// \brief Write every event as a complete event in the Chrome trace event
+  /// format.
+  void write(raw_ostream &OS) const;
+};
+
+/// \brief Records the time from its construction to its destruction as an
+/// event of the active time trace, if there is one.
+class TimeTraceScope {
+  TimeTrace *Trace;
+  const char *Name;
+  std::string Detail;
+
+  TimeTraceScope(const TimeTraceScope &) LLVM_DELETED_FUNCTION;
+  void operator=(const TimeTraceScope &) LLVM_DELETED_FUNCTION;
+
+public:
+  explicit TimeTraceScope(const char *Name, StringRef Detail = StringRef())
+    : Trace(TimeTrace::getActive()), Name(Name),
+      Detail(Trace ? Detail.str() : std::string()) {
+    if (Trace)
+      Trace->begin();
+  }
+
+  ~TimeTraceScope() {
+    if (Trace)
+      Trace->end(Name, Detail);
+  }
+
+  /// \brief Whether the event is being recorded. Callers can test this
+  /// before computing an expensive detail.
+  bool isActive() const { return Trace != 0; }
+
+  /// \brief Set what the region operates on, once it is known.
+  void setDetail(StringRef NewDetail) {
+    if (Trace)
+      Detail = NewDetail;
+  }
+};
+
+} // end namespace clang
+
+#endif
@@ -47,6 +47,13 @@ ASTConsumer *CreateASTDeclNodeLister();
 // format; this is intended for particularly intense debugging.
 ASTConsumer *CreateASTDumperXML(raw_ostream &OS);
 
+// AST JSON-dumper: streams the AST to the given stream as JSON, one line per
+// top-level declaration, as declarations are parsed. Declarations can be
+// filtered by qualified name, by file name and by kind; see
+// -ast-dump-json in CC1Options.td.
+ASTConsumer *CreateASTDumperJSON(raw_ostream &OS, StringRef FilterString,
+                                 StringRef FileFilter, StringRef KindFilter);
+
 // Graphical AST viewer: for each function definition, creates a graph of
 // the AST and displays it with the graph viewer "dotty".  Also outputs
 // function declarations to stderr.
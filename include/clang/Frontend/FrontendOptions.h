@@ -27,6 +27,7 @@ namespace frontend {
     ASTDeclList,            ///< Parse ASTs and list Decl nodes.
     ASTDump,                ///< Parse ASTs and dump them.
     ASTDumpXML,             ///< Parse ASTs and dump them in XML.
+    ASTDumpJSON,            ///< Parse ASTs and stream them as JSON lines.
     ASTPrint,               ///< Parse ASTs and print them.
     ASTView,                ///< Parse ASTs and view them in Graphviz.
     DumpRawTokens,          ///< Dump out raw tokens.
@@ -125,6 +126,8 @@ public:
                                            /// metrics and statistics.
   unsigned ShowTimers : 1;                 ///< Show timers for individual
                                            /// actions.
+  unsigned ShowTemplateProfile : 1;        ///< Show the cost of template
+                                           /// instantiations.
   unsigned ShowVersion : 1;                ///< Show the -version text.
   unsigned FixWhatYouCan : 1;              ///< Apply fixes even if there are
                                            /// unfixable errors.
@@ -137,6 +140,9 @@ public:
                                            /// speed up parsing in cases you do
                                            /// not need them (e.g. with code
                                            /// completion).
+  unsigned SkipFunctionTemplateInstantiations : 1; ///< Skip implicit
+                                           /// instantiation of function
+                                           /// template bodies.
   unsigned UseGlobalModuleIndex : 1;       ///< Whether we can use the
                                            ///< global module index if available.
   unsigned GenerateGlobalModuleIndex : 1;  ///< Whether we can generate the
@@ -175,6 +181,23 @@ public:
   /// If given, filter dumped AST Decl nodes by this substring.
   std::string ASTDumpFilter;
 
+  /// If given, only dump AST Decl nodes from files whose name contains this
+  /// substring.
+  std::string ASTDumpFileFilter;
+
+  /// If given, only dump AST Decl nodes of this kind.
+  std::string ASTDumpKindFilter;
+
+  /// If given, the file to write a JSON breakdown of AST memory use to.
+  std::string ASTMemoryStatsFile;
+
+  /// If given, the file to write a trace of template instantiations to.
+  std::string TemplateProfileTraceFile;
+
+  /// If given, the file to write a trace of the time spent in each phase of
+  /// the compilation to.
+  std::string TimeTraceFile;
+
   /// If given, enable code completion at the provided location.
   ParsedSourceLocation CodeCompletionAt;
 
@@ -210,10 +233,12 @@ public:
 public:
   FrontendOptions() :
     DisableFree(false), RelocatablePCH(false), ShowHelp(false),
-    ShowStats(false), ShowTimers(false), ShowVersion(false),
+    ShowStats(false), ShowTimers(false), ShowTemplateProfile(false),
+    ShowVersion(false),
     FixWhatYouCan(false), FixOnlyWarnings(false), FixAndRecompile(false),
     FixToTemporaries(false), ARCMTMigrateEmitARCErrors(false),
-    SkipFunctionBodies(false), UseGlobalModuleIndex(true),
+    SkipFunctionBodies(false), SkipFunctionTemplateInstantiations(false),
+    UseGlobalModuleIndex(true),
     GenerateGlobalModuleIndex(true),
     ARCMTAction(ARCMT_None), ObjCMTAction(ObjCMT_None),
     ProgramAction(frontend::ParseSyntaxOnly)
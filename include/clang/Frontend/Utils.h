@@ -57,6 +57,11 @@ void InitializePreprocessor(Preprocessor &PP,
                             const HeaderSearchOptions &HSOpts,
                             const FrontendOptions &FEOpts);
 
+/// getNumCachedPredefinesHits - Returns the number of times the predefines
+/// of the target and language configuration were reused from an earlier
+/// compilation in this process.
+unsigned getNumCachedPredefinesHits();
+
 /// ProcessWarningOptions - Initialize the diagnostic client and process the
 /// warning options specified on the command line.
 void ProcessWarningOptions(DiagnosticsEngine &Diags,
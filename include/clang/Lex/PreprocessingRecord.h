@@ -19,6 +19,7 @@
 #include "clang/Lex/PPCallbacks.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
@@ -292,9 +293,25 @@ namespace clang {
     /// \brief Allocator used to store preprocessing objects.
     llvm::BumpPtrAllocator BumpAlloc;
 
+    /// \brief A reference to a local preprocessed entity.
+    ///
+    /// Macro expansions make up the bulk of a detailed preprocessing record,
+    /// so they are stored compactly as the definition of the expanded macro
+    /// and only turned into a \c MacroExpansion object when a client asks for
+    /// the entity. All other entities are stored directly.
+    typedef llvm::PointerUnion<PreprocessedEntity *, MacroDefinition *>
+      LocalEntityRef;
+
+    /// \brief The source ranges of the local preprocessed entities in this
+    /// record, in order they were seen.
+    ///
+    /// Kept apart from \c PreprocessedEntities so that range queries do not
+    /// have to materialize the entities they search through.
+    std::vector<SourceRange> PreprocessedEntityRanges;
+
     /// \brief The set of preprocessed entities in this record, in order they
-    /// were seen.
-    std::vector<PreprocessedEntity *> PreprocessedEntities;
+    /// were seen, parallel to \c PreprocessedEntityRanges.
+    std::vector<LocalEntityRef> PreprocessedEntities;
     
     /// \brief The set of preprocessed entities in this record that have been
     /// loaded from external sources.
@@ -335,6 +352,13 @@ namespace clang {
 
     /// \brief Retrieve the loaded preprocessed entity at the given index.
     PreprocessedEntity *getLoadedPreprocessedEntity(unsigned Index);
+
+    /// \brief Retrieve the local preprocessed entity at the given index,
+    /// materializing it if it is stored in compact form.
+    PreprocessedEntity *getLocalPreprocessedEntity(unsigned Index);
+
+    /// \brief Add a local entity with the given source range to this record.
+    PPEntityID addLocalEntity(SourceRange Range, LocalEntityRef Ref);
     
     /// \brief Determine the number of preprocessed entities that were
     /// loaded (or can be loaded) from an external source.
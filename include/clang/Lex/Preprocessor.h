@@ -343,6 +343,7 @@ class Preprocessor : public RefCountedBase<Preprocessor> {
   unsigned NumMacroExpanded, NumFnMacroExpanded, NumBuiltinMacroExpanded;
   unsigned NumFastMacroExpanded, NumTokenPaste, NumFastTokenPaste;
   unsigned NumSkipped;
+  unsigned NumBacktrackedTokens;
 
   /// Predefines - This string is the predefined macros that preprocessor
   /// should use from the command line etc.
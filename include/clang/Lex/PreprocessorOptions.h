@@ -89,6 +89,11 @@ public:
   /// If given, a PTH cache file to use for speeding up header parsing.
   std::string TokenCache;
 
+  /// \brief If given, a dependency file (as written by -MD for a previous
+  /// build) listing files whose contents should be prefetched in the
+  /// background before preprocessing starts.
+  std::string PrefetchDependencyFile;
+
   /// \brief True if the SourceManager should report the original file name for
   /// contents of files that were remapped to other files. Defaults to true.
   bool RemappedFilesKeepOriginalName;
@@ -222,6 +227,7 @@ public:
     ImplicitPCHInclude.clear();
     ImplicitPTHInclude.clear();
     TokenCache.clear();
+    PrefetchDependencyFile.clear();
     RetainRemappedFileBuffers = true;
     PrecompiledPreambleBytes.first = 0;
     PrecompiledPreambleBytes.second = 0;
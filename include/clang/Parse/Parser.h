@@ -20,6 +20,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/DeclSpec.h"
 #include "clang/Sema/Sema.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/OwningPtr.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Compiler.h"
@@ -180,6 +181,38 @@ class Parser : public CodeCompletionHandler {
   /// \brief Identifiers which have been declared within a tentative parse.
   SmallVector<IdentifierInfo *, 8> TentativelyDeclaredIdentifiers;
 
+  /// \brief The kinds of disambiguation queries whose results are memoized.
+  enum TentativeQueryKind {
+    TQ_SimpleDeclaration,
+    TQ_ForRangeDeclaration,
+    TQ_ConditionDeclaration,
+    TQ_TypeIdInParens,
+    TQ_TypeIdAsTemplateArgument,
+    TQ_FunctionDeclarator
+  };
+
+  /// \brief Identifies a disambiguation query by the location of its first
+  /// token, its kind (including the parser state it depends on) and the
+  /// identifier tentatively declared when it was made, if any.
+  typedef std::pair<std::pair<unsigned, unsigned>, IdentifierInfo *>
+    TentativeQueryKey;
+
+  /// \brief The results of the disambiguation queries that needed a
+  /// tentative parse, so that nested ambiguous constructs are not scanned
+  /// again each time an enclosing construct is reparsed.
+  ///
+  /// The low bit of each entry is the result of the query and the next bit
+  /// is whether it was ambiguous.
+  llvm::DenseMap<TentativeQueryKey, unsigned char> TentativeQueryCache;
+
+  /// \brief The generation of the identifier resolver when the entries in
+  /// TentativeQueryCache were computed.
+  unsigned TentativeQueryCacheGeneration;
+
+  // Statistics.
+  unsigned NumTentativeQueries;
+  unsigned NumTentativeQueryCacheHits;
+
   IdentifierInfo *getSEHExceptKeyword();
 
   /// True if we are within an Objective-C container while parsing C-like decls.
@@ -195,6 +228,8 @@ public:
   Parser(Preprocessor &PP, Sema &Actions, bool SkipFunctionBodies);
   ~Parser();
 
+  void PrintStats() const;
+
   const LangOptions &getLangOpts() const { return PP.getLangOpts(); }
   const TargetInfo &getTargetInfo() const { return PP.getTargetInfo(); }
   Preprocessor &getPreprocessor() const { return PP; }
@@ -1727,6 +1762,20 @@ private:
     return isCXXTypeId(Context, isAmbiguous);
   }
 
+  /// \brief Compute the key of a disambiguation query of kind \p Kind that
+  /// starts at the current token. Returns false if its result cannot be
+  /// memoized.
+  bool getTentativeQueryKey(TentativeQueryKind Kind, TentativeQueryKey &Key);
+
+  /// \brief Find the memoized result of the disambiguation query \p Key.
+  /// Returns false if it has not been made since name lookup last changed.
+  bool getCachedTentativeQuery(const TentativeQueryKey &Key, bool &Result,
+                               bool &IsAmbiguous);
+
+  /// \brief Memoize the result of the disambiguation query \p Key.
+  void cacheTentativeQuery(const TentativeQueryKey &Key, bool Result,
+                           bool IsAmbiguous);
+
   /// TPResult - Used as the result value for functions whose purpose is to
   /// disambiguate C++ constructs by "tentatively parsing" them.
   /// This is a class instead of a simple enum because the implicit enum-to-bool
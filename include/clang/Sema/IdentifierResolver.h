@@ -186,6 +186,19 @@ public:
   ///
   /// \returns true if the declaration was added, false otherwise.
   bool tryAddTopLevelDecl(NamedDecl *D, DeclarationName Name);
+
+  /// \brief Returns a counter that changes whenever a change to the resolver
+  /// may change whether a name refers to a type, a template or a namespace,
+  /// or whenever noteLookupChanged() is called.
+  ///
+  /// Declarations of anything else only change it when they hide, or stop
+  /// hiding, such a declaration. Clients such as the parser's disambiguation
+  /// cache can use it to tell whether what they computed may be stale.
+  unsigned getGeneration() const { return Generation; }
+
+  /// \brief Note that the results of unqualified name lookup may have changed
+  /// without a change to the resolver, e.g., because of a using-directive.
+  void noteLookupChanged() { ++Generation; }
   
   explicit IdentifierResolver(Preprocessor &PP);
   ~IdentifierResolver();
@@ -193,11 +206,16 @@ public:
 private:
   const LangOptions &LangOpt;
   Preprocessor &PP;
+  unsigned Generation;
   
   class IdDeclInfoMap;
   IdDeclInfoMap *IdDeclInfos;
 
   void updatingIdentifier(IdentifierInfo &II);
+
+  /// \brief Bump the generation if adding, removing or replacing \p D may
+  /// change the kind of entity its name refers to.
+  void noteDeclChange(NamedDecl *D);
   void readingIdentifier(IdentifierInfo &II);
   
   /// FETokenInfo contains a Decl pointer if lower bit == 0.
@@ -191,6 +191,10 @@ public:
                  llvm::DenseMap<const CXXRecordDecl *, CharUnits> &BaseOffsets,
           llvm::DenseMap<const CXXRecordDecl *, CharUnits> &VirtualBaseOffsets);
 
+  /// \brief Retrieve the complete layout that was stored for the given
+  /// record by any of the sources, if any.
+  virtual const ASTRecordLayout *getStoredRecordLayout(const RecordDecl *Record);
+
   /// Return the amount of memory used by memory buffers, breaking down
   /// by heap-backed versus mmap'ed memory.
   virtual void getMemoryBufferSizes(MemoryBufferSizes &sizes) const;
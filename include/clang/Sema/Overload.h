@@ -741,7 +741,27 @@ namespace clang {
   /// OverloadCandidateSet - A set of overload candidates, used in C++
   /// overload resolution (C++ 13.3).
   class OverloadCandidateSet {
+  public:
+    /// \brief A candidate that was rejected because the call has the wrong
+    /// number of arguments for it, before an OverloadCandidate (and its
+    /// conversion sequences) was built.
+    ///
+    /// Only the information needed to describe the candidate in a note is
+    /// kept; NoteCandidates builds the full candidate on demand.
+    struct RejectedCandidate {
+      FunctionDecl *Function;
+      DeclAccessPair FoundDecl;
+      unsigned ExplicitCallArguments;
+      OverloadFailureKind FailureKind;
+
+      /// \brief Whether \c Function is the pattern of a function template,
+      /// in which case the failure is reported as a deduction failure.
+      bool IsTemplate;
+    };
+
+  private:
     SmallVector<OverloadCandidate, 16> Candidates;
+    SmallVector<RejectedCandidate, 16> RejectedCandidates;
     llvm::SmallPtrSet<Decl *, 16> Functions;
 
     // Allocator for OverloadCandidate::Conversions. We store the first few
@@ -777,8 +797,29 @@ namespace clang {
     iterator begin() { return Candidates.begin(); }
     iterator end() { return Candidates.end(); }
 
-    size_t size() const { return Candidates.size(); }
-    bool empty() const { return Candidates.empty(); }
+    /// \brief The number of candidates, including those rejected on arity,
+    /// which are not visited by \c begin() and \c end().
+    size_t size() const {
+      return Candidates.size() + RejectedCandidates.size();
+    }
+    bool empty() const {
+      return Candidates.empty() && RejectedCandidates.empty();
+    }
+
+    /// \brief Record a candidate that cannot be viable because the call has
+    /// the wrong number of arguments for it.
+    void addRejectedCandidate(FunctionDecl *Function, DeclAccessPair FoundDecl,
+                              unsigned NumArgs,
+                              OverloadFailureKind FailureKind,
+                              bool IsTemplate) {
+      RejectedCandidate R;
+      R.Function = Function;
+      R.FoundDecl = FoundDecl;
+      R.ExplicitCallArguments = NumArgs;
+      R.FailureKind = FailureKind;
+      R.IsTemplate = IsTemplate;
+      RejectedCandidates.push_back(R);
+    }
 
     /// \brief Add a new candidate with NumConversions conversion sequence slots
     /// to the overload set.
@@ -157,6 +157,7 @@ namespace clang {
   class TypedefDecl;
   class TypedefNameDecl;
   class TypeLoc;
+  class TypoCorrectionIndex;
   class UnqualifiedId;
   class UnresolvedLookupExpr;
   class UnresolvedMemberExpr;
@@ -181,6 +182,7 @@ namespace sema {
   class LambdaScopeInfo;
   class PossiblyUnreachableDiag;
   class TemplateDeductionInfo;
+  class TemplateInstantiationProfiler;
 }
 
 // FIXME: No way to easily map from TemplateTypeParmTypes to
@@ -380,6 +382,20 @@ public:
     OpaqueParser = P;
   }
 
+  /// \brief The inline member functions whose bodies the parser has stored
+  /// without parsing them, because of -fdelayed-inline-method-parsing.
+  ///
+  /// The bodies of those that are used are parsed through the late template
+  /// parser callback at the end of the translation unit.
+  SmallVector<FunctionDecl *, 16> LateParsedInlineMethods;
+
+  /// \brief The identifiers that appear in the stored bodies of the
+  /// late-parsed inline methods.
+  ///
+  /// File scope declarations with these names are not diagnosed as unused
+  /// while some of the bodies have not been parsed.
+  llvm::SmallPtrSet<IdentifierInfo *, 32> LateParsedInlineMethodNames;
+
   class DelayedDiagnostics;
 
   class DelayedDiagnosticsState {
@@ -4481,6 +4497,9 @@ public:
   void ActOnFinishDelayedCXXMethodDeclaration(Scope *S, Decl *Method);
   void ActOnFinishDelayedMemberInitializers(Decl *Record);
   void MarkAsLateParsedTemplate(FunctionDecl *FD, bool Flag = true);
+  void MarkAsLateParsedInlineMethod(FunctionDecl *FD,
+                                    const CachedTokens &Toks);
+  bool ParseUsedLateParsedInlineMethods();
   bool IsInsideALocalClassWithinATemplateFunction();
 
   Decl *ActOnStaticAssertDeclaration(SourceLocation StaticAssertLoc,
@@ -5524,6 +5543,44 @@ public:
                           FunctionDecl *&Specialization,
                           sema::TemplateDeductionInfo &Info);
 
+  TemplateDeductionResult
+  DeduceTemplateArgumentsFromCall(FunctionTemplateDecl *FunctionTemplate,
+                               TemplateArgumentListInfo *ExplicitTemplateArgs,
+                                  ArrayRef<Expr *> Args,
+                                  FunctionDecl *&Specialization,
+                                  sema::TemplateDeductionInfo &Info);
+
+  /// \brief The outcome of template argument deduction from a call, for a
+  /// call whose outcome depends only on the types and value categories of
+  /// its arguments.
+  class CachedTemplateDeduction : public llvm::FastFoldingSetNode {
+  public:
+    CachedTemplateDeduction(const llvm::FoldingSetNodeID &ID)
+      : FastFoldingSetNode(ID), Result(TDK_Success), Specialization(0),
+        Param(0) {}
+
+    TemplateDeductionResult Result;
+
+    /// \brief The specialization produced by successful deduction.
+    FunctionDecl *Specialization;
+
+    /// \brief The opaque value of the template parameter for which
+    /// deduction failed, if any.
+    void *Param;
+
+    /// \brief The template arguments describing a deduction failure.
+    TemplateArgument FirstArg, SecondArg;
+  };
+
+  /// \brief A cache of template argument deduction results for calls to
+  /// function templates, used by \c DeduceTemplateArguments.
+  llvm::FoldingSet<CachedTemplateDeduction> TemplateDeductionCache;
+
+  /// \brief The number of lookups into, and hits in, the template deduction
+  /// cache.
+  unsigned NumTemplateDeductionCacheLookups;
+  unsigned NumTemplateDeductionCacheHits;
+
   TemplateDeductionResult
   DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
                           TemplateArgumentListInfo *ExplicitTemplateArgs,
@@ -5724,6 +5781,10 @@ public:
   SmallVector<ActiveTemplateInstantiation, 16>
     ActiveTemplateInstantiations;
 
+  /// \brief If non-null, the profiler that is told about every push onto and
+  /// pop off \c ActiveTemplateInstantiations.
+  OwningPtr<sema::TemplateInstantiationProfiler> InstantiationProfiler;
+
   /// \brief Whether we are in a SFINAE context that is not associated with
   /// template instantiation.
   ///
@@ -5882,6 +5943,10 @@ public:
     bool CheckInstantiationDepth(SourceLocation PointOfInstantiation,
                                  SourceRange InstantiationRange);
 
+    /// \brief Push \p Inst on the stack of active instantiations, and tell
+    /// the instantiation profiler, if any, that it started.
+    void PushInstantiation(const ActiveTemplateInstantiation &Inst);
+
     InstantiatingTemplate(const InstantiatingTemplate&) LLVM_DELETED_FUNCTION;
 
     InstantiatingTemplate&
@@ -5960,6 +6025,10 @@ public:
   /// string represents a keyword.
   UnqualifiedTyposCorrectedMap UnqualifiedTyposCorrected;
 
+  /// \brief The names that typo correction may suggest, built on the first
+  /// unqualified typo correction.
+  OwningPtr<TypoCorrectionIndex> TypoIndex;
+
   /// \brief Worker object for performing CFG-based warnings.
   sema::AnalysisBasedWarnings AnalysisWarnings;
 
@@ -5977,6 +6046,14 @@ public:
   /// but have not yet been performed.
   std::deque<PendingImplicitInstantiation> PendingInstantiations;
 
+  /// \brief Whether to skip the implicit instantiation of function template
+  /// specializations and member functions of class templates.
+  ///
+  /// Bodies are still instantiated for constexpr functions, which constant
+  /// evaluation needs, and for functions whose bodies the ASTConsumer does
+  /// not want skipped (see ASTConsumer::shouldSkipFunctionBody).
+  bool SkipFunctionTemplateInstantiations;
+
   /// \brief The queue of implicit template instantiations that are required
   /// and must be performed within the current local scope.
   ///
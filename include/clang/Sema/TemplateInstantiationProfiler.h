@@ -0,0 +1,103 @@
+//===--- TemplateInstantiationProfiler.h - Instantiation costs -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines TemplateInstantiationProfiler, a worker object used by
+// Sema to attribute compile time and AST memory to template instantiations.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_SEMA_TEMPLATE_INSTANTIATION_PROFILER_H
+#define LLVM_CLANG_SEMA_TEMPLATE_INSTANTIATION_PROFILER_H
+
+#include "clang/Basic/LLVM.h"
+#include "clang/Basic/TimeTrace.h"
+#include "clang/Sema/Sema.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+
+namespace clang {
+
+class ASTContext;
+
+namespace sema {
+
+/// \brief Records the cost of each template instantiation performed by Sema.
+///
+/// Sema notifies the profiler whenever an entry is pushed onto or popped off
+/// its stack of active template instantiations. For each entry the profiler
+/// measures the wall time spent and the growth of the AST allocator, and
+/// splits both into the part spent in nested instantiations and the part
+/// spent in the entry itself ("self" cost).
+///
+/// Costs are aggregated per specialization (e.g. \c vector<int>), per
+/// template (e.g. \c std::vector) and per file declaring the template. Each
+/// instantiation is also recorded as an event of a TimeTrace, which can be
+/// written in the Chrome trace event format, and of the time trace active
+/// for the compilation, if any.
+///
+/// The AST allocator grows a slab at a time, so the byte count of a single
+/// instantiation is coarse; the counts become meaningful when aggregated.
+class TemplateInstantiationProfiler {
+public:
+  /// \brief The aggregated cost of a group of instantiations.
+  struct Cost {
+    unsigned Count;
+    unsigned Nested;
+    double Time;
+    double SelfTime;
+    uint64_t SelfBytes;
+
+    Cost() : Count(0), Nested(0), Time(0), SelfTime(0), SelfBytes(0) {}
+  };
+
+  explicit TemplateInstantiationProfiler(ASTContext &Context);
+
+  /// \brief Note that Sema pushed \p Inst onto its instantiation stack.
+  void startInstantiation(const Sema::ActiveTemplateInstantiation &Inst);
+
+  /// \brief Note that Sema popped \p Inst off its instantiation stack.
+  void finishInstantiation(const Sema::ActiveTemplateInstantiation &Inst);
+
+  /// \brief Print the most expensive specializations, templates and files,
+  /// sorted by self time.
+  ///
+  /// \param Limit The number of entries to print in each table.
+  void PrintReport(raw_ostream &OS, unsigned Limit = 20) const;
+
+  /// \brief Write every recorded instantiation as a complete event in the
+  /// Chrome trace event format.
+  void WriteTrace(raw_ostream &OS) const;
+
+private:
+  struct Frame {
+    double Start;
+    size_t StartBytes;
+    double ChildTime;
+    size_t ChildBytes;
+    unsigned Nested;
+  };
+
+  typedef llvm::StringMap<Cost> CostMap;
+
+  ASTContext &Context;
+  SmallVector<Frame, 16> Stack;
+  TimeTrace Trace;
+  CostMap BySpecialization;
+  CostMap ByTemplate;
+  CostMap ByFile;
+  Cost Total;
+
+  static void PrintTable(raw_ostream &OS, StringRef Title,
+                         const CostMap &Costs, unsigned Limit);
+};
+
+} // end namespace sema
+} // end namespace clang
+
+#endif
@@ -0,0 +1,117 @@
+//===--- TypoCorrectionIndex.h - Index of typo correction names -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines TypoCorrectionIndex, which lets Sema::CorrectTypo find
+// the identifiers that could be close to a typo without computing the edit
+// distance to every identifier in the translation unit.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_SEMA_TYPOCORRECTIONINDEX_H
+#define LLVM_CLANG_SEMA_TYPOCORRECTIONINDEX_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace clang {
+
+class IdentifierTable;
+
+namespace Builtin {
+  class Context;
+}
+
+/// \brief An index of every name that typo correction may suggest.
+///
+/// Names are bucketed by length and tagged with a 64-bit signature of the
+/// characters they contain. Since a single edit changes the length of a name
+/// by at most one and the set of characters it contains by at most two, both
+/// give a lower bound on the edit distance to the typo, and names that cannot
+/// be close enough are skipped without computing their edit distance.
+///
+/// The index is built on the first typo correction and then extended with
+/// the identifiers added to the table since, and with the identifiers of the
+/// external source whenever it loads more, so it is shared by all
+/// corrections in a translation unit.
+class TypoCorrectionIndex {
+  struct Entry {
+    StringRef Name;
+    uint64_t Signature;
+  };
+
+  /// \brief The names in the index, used to unique them.
+  llvm::StringMap<char, llvm::BumpPtrAllocator> Names;
+
+  /// \brief The names in the index, bucketed by length.
+  std::vector<std::vector<Entry> > ByLength;
+
+  /// \brief The identifier table whose names are indexed.
+  IdentifierTable &Idents;
+
+  /// \brief The names of the identifiers added to the table since the index
+  /// was last updated.
+  std::vector<StringRef> NewIdentifierNames;
+
+  /// \brief Whether the identifier table and the builtins have been added to
+  /// the index.
+  bool Initialized;
+
+  /// \brief Whether the identifiers of the external source have been added
+  /// to the index.
+  bool IndexedExternalNames;
+
+  /// \brief The generation of the external identifier source when its
+  /// identifiers were last added to the index.
+  unsigned ExternalGeneration;
+
+  // Statistics.
+  unsigned NumLookups;
+  unsigned NumCompared;
+  unsigned NumPruned;
+  unsigned NumOverBudget;
+
+  TypoCorrectionIndex(const TypoCorrectionIndex &) LLVM_DELETED_FUNCTION;
+  void operator=(const TypoCorrectionIndex &) LLVM_DELETED_FUNCTION;
+
+public:
+  explicit TypoCorrectionIndex(IdentifierTable &Idents);
+  ~TypoCorrectionIndex();
+
+  /// \brief Add the names in the identifier table, the identifiers known to
+  /// its external source and the available builtins that are not yet in the
+  /// index.
+  void update(const Builtin::Context &Builtins);
+
+  /// \brief Add \p Name to the index, unless it is already there.
+  void insert(StringRef Name);
+
+  /// \brief Find the names that may be within \p MaxDistance edits of
+  /// \p Typo.
+  ///
+  /// Names whose length is closest to that of the typo are returned first.
+  ///
+  /// \param Budget If non-zero, the maximum number of names to return.
+  ///
+  /// \returns true if names were left out because of the budget.
+  bool lookup(StringRef Typo, unsigned MaxDistance, unsigned Budget,
+              SmallVectorImpl<StringRef> &Candidates);
+
+  /// \brief The number of names in the index.
+  unsigned size() const { return Names.size(); }
+
+  void PrintStats() const;
+};
+
+} // end namespace clang
+
+#endif
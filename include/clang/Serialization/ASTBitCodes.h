@@ -528,7 +528,22 @@ namespace clang {
 
       /// \brief Record code for undefined but used functions and variables that
       /// need a definition in this TU.
-      UNDEFINED_BUT_USED = 49
+      UNDEFINED_BUT_USED = 49,
+
+      /// \brief Record code for the layouts of the records defined in this
+      /// AST file.
+      ///
+      /// Each layout consists of the record's declaration ID, its size, data
+      /// size and alignment in characters, and the offset in bits of each
+      /// field, preceded by their number. A flag says whether C++ information
+      /// follows: whether the record has its own vtable pointer, the vbtable
+      /// pointer offset, the non-virtual size and alignment, the size of the
+      /// largest empty subobject, the primary base's declaration ID (or 0)
+      /// and whether it is virtual, then the declaration ID and offset of
+      /// each direct non-virtual base and the declaration ID, offset and
+      /// vtordisp flag of each virtual base, each list preceded by its
+      /// length.
+      RECORD_LAYOUTS = 50
     };
 
     /// \brief Record types used within a source manager block.
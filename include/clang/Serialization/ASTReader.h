@@ -1531,6 +1531,10 @@ public:
   /// in all loaded AST files.
   virtual IdentifierIterator *getIdentifiers() const;
 
+  /// \brief Retrieve the generation of the set of loaded AST files, which
+  /// changes whenever one is loaded.
+  virtual unsigned getGeneration() const { return CurrentGeneration; }
+
   /// \brief Load the contents of the global method pool for a given
   /// selector.
   virtual void ReadMethodPool(Selector Sel);
@@ -1540,6 +1544,11 @@ public:
   virtual void ReadKnownNamespaces(
                            SmallVectorImpl<NamespaceDecl *> &Namespaces);
 
+  /// \brief Build the layout of a record defined in an AST file from the
+  /// one the AST file stored, if any.
+  virtual const ASTRecordLayout *
+  getStoredRecordLayout(const RecordDecl *Record);
+
   virtual void ReadUndefinedButUsed(
                         llvm::DenseMap<NamedDecl *, SourceLocation> &Undefined);
 
@@ -433,6 +433,7 @@ private:
   void WriteTypeDeclOffsets();
   void WriteFileDeclIDsMap();
   void WriteComments();
+  void WriteRecordLayouts();
   void WriteSelectors(Sema &SemaRef);
   void WriteReferencedSelectorsPool(Sema &SemaRef);
   void WriteIdentifierTable(Preprocessor &PP, IdentifierResolver &IdResolver,
@@ -374,6 +374,18 @@ public:
   /// module.
   SmallVector<uint64_t, 1> ObjCCategories;
 
+  /// \brief The layouts of the records defined in this module file, in the
+  /// format of the RECORD_LAYOUTS record.
+  SmallVector<uint64_t, 1> RecordLayouts;
+
+  /// \brief Mapping from the ID of a record definition, as known in this
+  /// module file, to the position within RecordLayouts where its layout
+  /// starts.
+  ///
+  /// This is built on first use, since the declaration IDs cannot be mapped
+  /// until the whole module file has been read.
+  llvm::DenseMap<serialization::DeclID, unsigned> RecordLayoutPositions;
+
   // === Types ===
 
   /// \brief The number of types in this AST file.
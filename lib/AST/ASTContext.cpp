@@ -671,6 +671,10 @@ ASTContext::ASTContext(LangOptions& LOpts, SourceManager &SM,
 {
   if (size_reserve > 0) Types.reserve(size_reserve);
   TUDecl = TranslationUnitDecl::Create(*this);
+  NumConstexprCallCacheHits = NumConstexprCallCacheMisses = 0;
+  NumConstantEvaluations = 0;
+  NumConstantEvaluationSteps = NumConstantEvaluationCachedSteps = 0;
+  MaxConstantEvaluationSteps = 0;
   
   if (!DelayInitialization) {
     assert(t && "No target supplied for ASTContext initialization");
@@ -718,6 +722,25 @@ ASTContext::setExternalSource(OwningPtr<ExternalASTSource> &Source) {
   ExternalSource.reset(Source.take());
 }
 
+/// \brief Add \p RHS to \p LHS, saturating instead of overflowing.
+static uint64_t addSaturating(uint64_t LHS, uint64_t RHS) {
+  return LHS > ~uint64_t(0) - RHS ? ~uint64_t(0) : LHS + RHS;
+}
+
+void ASTContext::noteConstantEvaluation(uint64_t Steps, uint64_t CachedSteps,
+                                        SourceLocation Loc) {
+  ++NumConstantEvaluations;
+  NumConstantEvaluationSteps = addSaturating(NumConstantEvaluationSteps,
+                                             Steps);
+  NumConstantEvaluationCachedSteps =
+    addSaturating(NumConstantEvaluationCachedSteps, CachedSteps);
+  uint64_t Cost = addSaturating(Steps, CachedSteps);
+  if (Cost > MaxConstantEvaluationSteps) {
+    MaxConstantEvaluationSteps = Cost;
+    MaxConstantEvaluationLoc = Loc;
+  }
+}
+
 void ASTContext::PrintStats() const {
   llvm::errs() << "\n*** AST Context Stats:\n";
   llvm::errs() << "  " << Types.size() << " types total.\n";
@@ -769,6 +792,22 @@ void ASTContext::PrintStats() const {
                << NumImplicitDestructors
                << " implicit destructors created\n";
 
+  if (getLangOpts().CPlusPlus11)
+    llvm::errs() << NumConstexprCallCacheHits << "/"
+                 << (NumConstexprCallCacheHits + NumConstexprCallCacheMisses)
+                 << " constexpr calls answered from the call cache ("
+                 << ConstexprCallCache.size() << " entries)\n";
+  if (NumConstantEvaluations) {
+    llvm::errs() << NumConstantEvaluationSteps << " steps taken by "
+                 << NumConstantEvaluations << " constant evaluations\n";
+    llvm::errs() << "  " << NumConstantEvaluationCachedSteps
+                 << " more steps saved by the constexpr call cache\n";
+    llvm::errs() << "  most expensive evaluation cost "
+                 << MaxConstantEvaluationSteps << " steps at ";
+    MaxConstantEvaluationLoc.print(llvm::errs(), SourceMgr);
+    llvm::errs() << "\n";
+  }
+
   if (ExternalSource.get()) {
     llvm::errs() << "\n";
     ExternalSource->PrintStats();
@@ -7763,12 +7802,48 @@ MangleContext *ASTContext::createMangleContext() {
   llvm_unreachable("Unsupported ABI");
 }
 
+MangleContext &ASTContext::getMangleContext() {
+  if (!NameMangler)
+    NameMangler.reset(createMangleContext());
+  return *NameMangler;
+}
+
+StringRef ASTContext::getMangledName(const NamedDecl *D) {
+  StringRef &Name = MangledNames[cast<NamedDecl>(D->getCanonicalDecl())];
+  if (!Name.empty())
+    return Name;
+
+  MangleContext &Mangler = getMangleContext();
+  if (!Mangler.shouldMangleDeclName(D)) {
+    IdentifierInfo *II = D->getIdentifier();
+    assert(II && "Attempt to mangle unnamed decl.");
+    Name = II->getName();
+    return Name;
+  }
+
+  SmallString<256> Buffer;
+  llvm::raw_svector_ostream Out(Buffer);
+  if (const CXXConstructorDecl *CD = dyn_cast<CXXConstructorDecl>(D))
+    Mangler.mangleCXXCtor(CD, Ctor_Complete, Out);
+  else if (const CXXDestructorDecl *DD = dyn_cast<CXXDestructorDecl>(D))
+    Mangler.mangleCXXDtor(DD, Dtor_Complete, Out);
+  else
+    Mangler.mangleName(D, Out);
+  Out.flush();
+
+  char *Mem = static_cast<char *>(Allocate(Buffer.size(), 1));
+  std::copy(Buffer.begin(), Buffer.end(), Mem);
+  Name = StringRef(Mem, Buffer.size());
+  return Name;
+}
+
 CXXABI::~CXXABI() {}
 
 size_t ASTContext::getSideTableAllocatedMemory() const {
   return ASTRecordLayouts.getMemorySize()
     + llvm::capacity_in_bytes(ObjCLayouts)
     + llvm::capacity_in_bytes(KeyFunctions)
+    + llvm::capacity_in_bytes(MangledNames)
     + llvm::capacity_in_bytes(ObjCImpls)
     + llvm::capacity_in_bytes(BlockVarCopyInits)
     + llvm::capacity_in_bytes(DeclAttrs)
@@ -198,6 +198,16 @@ namespace {
     /// \brief Declaration (from, to) pairs that are known not to be equivalent
     /// (which we have already complained about).
     llvm::DenseSet<std::pair<Decl *, Decl *> > &NonEquivalentDecls;
+
+    /// \brief Declaration (from, to) pairs that earlier checks have proven
+    /// to be equivalent.
+    llvm::DenseSet<std::pair<Decl *, Decl *> > &EquivalentDecls;
+
+    /// \brief Whether one of the tentative equivalences was accepted only
+    /// because a tag declaration had no complete definition yet. Such results
+    /// may change once the definition is available, so they are not added to
+    /// EquivalentDecls.
+    bool SawIncompleteTag;
     
     /// \brief Whether we're being strict about the spelling of types when 
     /// unifying two types.
@@ -211,9 +221,11 @@ namespace {
 
     StructuralEquivalenceContext(ASTContext &C1, ASTContext &C2,
                llvm::DenseSet<std::pair<Decl *, Decl *> > &NonEquivalentDecls,
+               llvm::DenseSet<std::pair<Decl *, Decl *> > &EquivalentDecls,
                                  bool StrictTypeSpelling = false,
                                  bool Complain = true)
       : C1(C1), C2(C2), NonEquivalentDecls(NonEquivalentDecls),
+        EquivalentDecls(EquivalentDecls), SawIncompleteTag(false),
         StrictTypeSpelling(StrictTypeSpelling), Complain(Complain),
         LastDiagFromC2(false) {}
 
@@ -1255,22 +1267,27 @@ static bool IsStructurallyEquivalent(StructuralEquivalenceContext &Context,
 /// \brief Determine structural equivalence of two declarations.
 static bool IsStructurallyEquivalent(StructuralEquivalenceContext &Context,
                                      Decl *D1, Decl *D2) {
-  // FIXME: Check for known structural equivalences via a callback of some sort.
-  
+  std::pair<Decl *, Decl *> P(D1->getCanonicalDecl(), D2->getCanonicalDecl());
+
   // Check whether we already know that these two declarations are not
   // structurally equivalent.
-  if (Context.NonEquivalentDecls.count(std::make_pair(D1->getCanonicalDecl(),
-                                                      D2->getCanonicalDecl())))
+  if (Context.NonEquivalentDecls.count(P))
     return false;
-  
+
   // Determine whether we've already produced a tentative equivalence for D1.
-  Decl *&EquivToD1 = Context.TentativeEquivalences[D1->getCanonicalDecl()];
+  Decl *&EquivToD1 = Context.TentativeEquivalences[P.first];
   if (EquivToD1)
-    return EquivToD1 == D2->getCanonicalDecl();
-  
-  // Produce a tentative equivalence D1 <-> D2, which will be checked later.
-  EquivToD1 = D2->getCanonicalDecl();
-  Context.DeclsToCheck.push_back(D1->getCanonicalDecl());
+    return EquivToD1 == P.second;
+
+  EquivToD1 = P.second;
+
+  // If an earlier check already proved these declarations equivalent, there
+  // is nothing left to verify.
+  if (!Context.StrictTypeSpelling && Context.EquivalentDecls.count(P))
+    return true;
+
+  // Otherwise, the tentative equivalence D1 <-> D2 will be checked later.
+  Context.DeclsToCheck.push_back(P.first);
   return true;
 }
 
@@ -1290,6 +1307,16 @@ bool StructuralEquivalenceContext::IsStructurallyEquivalent(QualType T1,
   return !Finish();
 }
 
+/// \brief Determine whether the given declaration is a tag whose
+/// definition is missing or not yet complete.
+static bool isIncompleteTag(Decl *D) {
+  TagDecl *Tag = dyn_cast<TagDecl>(D);
+  if (!Tag)
+    return false;
+  TagDecl *Def = Tag->getDefinition();
+  return !Def || Def->isBeingDefined();
+}
+
 bool StructuralEquivalenceContext::Finish() {
   while (!DeclsToCheck.empty()) {
     // Check the next declaration.
@@ -1298,7 +1325,10 @@ bool StructuralEquivalenceContext::Finish() {
     
     Decl *D2 = TentativeEquivalences[D1];
     assert(D2 && "Unrecorded tentative equivalence?");
-    
+
+    if (isIncompleteTag(D1) || isIncompleteTag(D2))
+      SawIncompleteTag = true;
+
     bool Equivalent = true;
     
     // FIXME: Switch on all declaration kinds. For now, we're just going to
@@ -1397,7 +1427,16 @@ bool StructuralEquivalenceContext::Finish() {
     }
     // FIXME: Check other declaration kinds!
   }
-  
+
+  // Every tentative equivalence has now been verified. Remember them so that
+  // later checks involving the same declarations can stop early.
+  if (!StrictTypeSpelling && !SawIncompleteTag) {
+    for (llvm::DenseMap<Decl *, Decl *>::iterator
+           I = TentativeEquivalences.begin(), E = TentativeEquivalences.end();
+         I != E; ++I)
+      EquivalentDecls.insert(*I);
+  }
+
   return false;
 }
 
@@ -2149,6 +2188,7 @@ bool ASTNodeImporter::IsStructuralMatch(RecordDecl *FromRecord,
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
                                    Importer.getNonEquivalentDecls(),
+                                   Importer.getEquivalentDecls(),
                                    false, Complain);
   return Ctx.IsStructurallyEquivalent(FromRecord, ToRecord);
 }
@@ -2156,7 +2196,8 @@ bool ASTNodeImporter::IsStructuralMatch(RecordDecl *FromRecord,
 bool ASTNodeImporter::IsStructuralMatch(EnumDecl *FromEnum, EnumDecl *ToEnum) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(FromEnum, ToEnum);
 }
 
@@ -2175,7 +2216,8 @@ bool ASTNodeImporter::IsStructuralMatch(ClassTemplateDecl *From,
                                         ClassTemplateDecl *To) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(From, To);  
 }
 
@@ -4883,6 +4925,6 @@ bool ASTImporter::IsStructurallyEquivalent(QualType From, QualType To,
     return true;
       
   StructuralEquivalenceContext Ctx(FromContext, ToContext, NonEquivalentDecls,
-                                   false, Complain);
+                                   EquivalentDecls, false, Complain);
   return Ctx.IsStructurallyEquivalent(From, To);
 }
@@ -0,0 +1,268 @@
+//===--- ASTMemoryStats.cpp - Memory accounting for AST nodes -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements ASTContext::PrintMemoryStats, which breaks down the
+//  memory held by the AST by node kind and by the origin of each node.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclFriend.h"
+#include "clang/AST/DeclObjC.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/Expr.h"
+#include "clang/AST/ExprCXX.h"
+#include "clang/AST/ExprObjC.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/AST/StmtCXX.h"
+#include "clang/AST/StmtObjC.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+using namespace clang;
+
+namespace {
+
+/// \brief Where an AST node came from.
+enum NodeOrigin {
+  NO_MainFile,
+  NO_Header,
+  NO_Instantiation,
+  NO_External,
+  NO_Other
+};
+const unsigned NumNodeOrigins = NO_Other + 1;
+
+const char *const OriginNames[NumNodeOrigins] = {
+  "main file", "headers", "template instantiations", "AST files", "other"
+};
+
+/// \brief The number of nodes of one kind, and the bytes they occupy by
+/// origin.
+struct NodeKindStats {
+  const char *Category;
+  unsigned Count;
+  uint64_t Bytes[NumNodeOrigins];
+
+  NodeKindStats() : Category(0), Count(0) {
+    std::fill(Bytes, Bytes + NumNodeOrigins, 0);
+  }
+
+  uint64_t getTotalBytes() const {
+    uint64_t Total = 0;
+    for (unsigned I = 0; I != NumNodeOrigins; ++I)
+      Total += Bytes[I];
+    return Total;
+  }
+};
+
+typedef llvm::StringMap<NodeKindStats> NodeKindStatsMap;
+
+size_t getDeclSize(const Decl *D) {
+  switch (D->getKind()) {
+#define DECL(DERIVED, BASE) \
+  case Decl::DERIVED: return sizeof(DERIVED##Decl);
+#define ABSTRACT_DECL(DECL)
+#include "clang/AST/DeclNodes.inc"
+  }
+  llvm_unreachable("unknown decl kind");
+}
+
+size_t getStmtSize(const Stmt *S) {
+  switch (S->getStmtClass()) {
+  case Stmt::NoStmtClass: llvm_unreachable("statement without class");
+#define STMT(CLASS, PARENT) \
+  case Stmt::CLASS##Class: return sizeof(CLASS);
+#define ABSTRACT_STMT(STMT)
+#include "clang/AST/StmtNodes.inc"
+  }
+  llvm_unreachable("unknown stmt class");
+}
+
+size_t getTypeSize(const Type *T) {
+  switch (T->getTypeClass()) {
+#define TYPE(Class, Base) \
+  case Type::Class: return sizeof(Class##Type);
+#define ABSTRACT_TYPE(Class, Base)
+#include "clang/AST/TypeNodes.def"
+  }
+  llvm_unreachable("unknown type class");
+}
+
+bool isInstantiation(const Decl *D) {
+  if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D))
+    return isTemplateInstantiation(FD->getTemplateSpecializationKind());
+  if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D))
+    return isTemplateInstantiation(RD->getTemplateSpecializationKind());
+  if (const VarDecl *VD = dyn_cast<VarDecl>(D))
+    return isTemplateInstantiation(VD->getTemplateSpecializationKind());
+  return false;
+}
+
+/// \brief Walks the AST, including implicit code and template
+/// instantiations, and attributes each node to its kind and origin.
+///
+/// Declarations from AST files are counted only as far as they have been
+/// deserialized: walking them as usual would load their contents and bodies.
+class MemoryStatsCollector
+  : public RecursiveASTVisitor<MemoryStatsCollector> {
+  const SourceManager &SM;
+  NodeKindStatsMap &Stats;
+  NodeOrigin CurrentOrigin;
+
+  void addNode(StringRef Kind, const char *Category, size_t Size) {
+    NodeKindStats &Entry = Stats[Kind];
+    Entry.Category = Category;
+    ++Entry.Count;
+    Entry.Bytes[CurrentOrigin] += Size;
+  }
+
+  NodeOrigin getOrigin(const Decl *D) const {
+    if (CurrentOrigin == NO_Instantiation || isInstantiation(D))
+      return NO_Instantiation;
+    SourceLocation Loc = D->getLocation();
+    if (Loc.isInvalid())
+      return CurrentOrigin;
+    FileID FID = SM.getFileID(SM.getExpansionLoc(Loc));
+    if (FID == SM.getMainFileID())
+      return NO_MainFile;
+    if (SM.getFileEntryForID(FID))
+      return NO_Header;
+    return NO_Other;
+  }
+
+public:
+  MemoryStatsCollector(const SourceManager &SM, NodeKindStatsMap &Stats)
+    : SM(SM), Stats(Stats), CurrentOrigin(NO_Other) { }
+
+  bool shouldVisitTemplateInstantiations() const { return true; }
+  bool shouldVisitImplicitCode() const { return true; }
+
+  bool TraverseDecl(Decl *D) {
+    if (!D)
+      return true;
+    NodeOrigin SavedOrigin = CurrentOrigin;
+    bool Result = true;
+    if (D->isFromASTFile()) {
+      CurrentOrigin = NO_External;
+      VisitDecl(D);
+      if (DeclContext *DC = dyn_cast<DeclContext>(D))
+        Result = TraverseLoadedDecls(DC);
+    } else {
+      CurrentOrigin = getOrigin(D);
+      Result = RecursiveASTVisitor<MemoryStatsCollector>::TraverseDecl(D);
+    }
+    CurrentOrigin = SavedOrigin;
+    return Result;
+  }
+
+  /// \brief Traverse the declarations of \p DC that have been loaded, without
+  /// loading the rest from the external source.
+  bool TraverseLoadedDecls(DeclContext *DC) {
+    for (DeclContext::decl_iterator D = DC->noload_decls_begin(),
+                                    DEnd = DC->noload_decls_end();
+         D != DEnd; ++D)
+      if (!TraverseDecl(*D))
+        return false;
+    return true;
+  }
+
+  bool VisitDecl(Decl *D) {
+    addNode(D->getDeclKindName(), "decl", getDeclSize(D));
+    return true;
+  }
+
+  bool VisitStmt(Stmt *S) {
+    addNode(S->getStmtClassName(), "stmt", getStmtSize(S));
+    return true;
+  }
+};
+
+bool compareByBytes(const NodeKindStatsMap::const_iterator &LHS,
+                    const NodeKindStatsMap::const_iterator &RHS) {
+  uint64_t LHSBytes = LHS->second.getTotalBytes();
+  uint64_t RHSBytes = RHS->second.getTotalBytes();
+  if (LHSBytes != RHSBytes)
+    return LHSBytes > RHSBytes;
+  return LHS->first() < RHS->first();
+}
+
+} // end anonymous namespace
+
+void ASTContext::PrintMemoryStats(raw_ostream &OS, bool JSON) const {
+  NodeKindStatsMap Stats;
+  MemoryStatsCollector Collector(SourceMgr, Stats);
+  TranslationUnitDecl *TU = getTranslationUnitDecl();
+  Collector.VisitDecl(TU);
+  Collector.TraverseLoadedDecls(TU);
+
+  // Types are uniqued across the translation unit, so they have no origin.
+  for (unsigned I = 0, N = Types.size(); I != N; ++I) {
+    NodeKindStats &Entry
+      = Stats[std::string(Types[I]->getTypeClassName()) + "Type"];
+    Entry.Category = "type";
+    ++Entry.Count;
+    Entry.Bytes[NO_Other] += getTypeSize(Types[I]);
+  }
+
+  SmallVector<NodeKindStatsMap::const_iterator, 64> Sorted;
+  uint64_t OriginBytes[NumNodeOrigins] = { 0, 0, 0, 0, 0 };
+  uint64_t AttributedBytes = 0;
+  for (NodeKindStatsMap::const_iterator I = Stats.begin(), E = Stats.end();
+       I != E; ++I) {
+    Sorted.push_back(I);
+    for (unsigned O = 0; O != NumNodeOrigins; ++O)
+      OriginBytes[O] += I->second.Bytes[O];
+    AttributedBytes += I->second.getTotalBytes();
+  }
+  std::sort(Sorted.begin(), Sorted.end(), compareByBytes);
+
+  uint64_t AllocatedBytes = getASTAllocatedMemory();
+  uint64_t SideTableBytes = getSideTableAllocatedMemory();
+
+  if (JSON) {
+    OS << "{\n  \"allocated\": " << AllocatedBytes
+       << ",\n  \"side_tables\": " << SideTableBytes
+       << ",\n  \"attributed\": " << AttributedBytes
+       << ",\n  \"origins\": {";
+    for (unsigned O = 0; O != NumNodeOrigins; ++O)
+      OS << (O ? ", " : "") << '"' << OriginNames[O] << "\": "
+         << OriginBytes[O];
+    OS << "},\n  \"kinds\": [";
+    for (unsigned I = 0, N = Sorted.size(); I != N; ++I) {
+      const NodeKindStats &Entry = Sorted[I]->second;
+      OS << (I ? "," : "") << "\n    {\"kind\": \"" << Sorted[I]->first()
+         << "\", \"category\": \"" << Entry.Category
+         << "\", \"count\": " << Entry.Count
+         << ", \"bytes\": " << Entry.getTotalBytes() << ", \"origins\": {";
+      for (unsigned O = 0; O != NumNodeOrigins; ++O)
+        OS << (O ? ", " : "") << '"' << OriginNames[O] << "\": "
+           << Entry.Bytes[O];
+      OS << "}}";
+    }
+    OS << "\n  ]\n}\n";
+    return;
+  }
+
+  OS << "\n*** AST Memory Stats:\n";
+  OS << "  " << AllocatedBytes << " bytes allocated for AST nodes, "
+     << AttributedBytes << " bytes attributed to node kinds.\n";
+  OS << "  " << SideTableBytes << " bytes in side tables.\n";
+  for (unsigned O = 0; O != NumNodeOrigins; ++O)
+    OS << "    " << OriginBytes[O] << " bytes from " << OriginNames[O]
+       << "\n";
+  for (unsigned I = 0, N = Sorted.size(); I != N; ++I) {
+    const NodeKindStats &Entry = Sorted[I]->second;
+    OS << "    " << Entry.getTotalBytes() << " bytes in " << Entry.Count
+       << " " << Sorted[I]->first() << " " << Entry.Category << "s\n";
+  }
+}
@@ -77,7 +77,57 @@ void CXXBasePaths::swap(CXXBasePaths &Other) {
   std::swap(DetectedVirtual, Other.DetectedVirtual);
 }
 
+bool ASTContext::getAllBaseClasses(const CXXRecordDecl *RD,
+                               ArrayRef<const CXXRecordDecl*> &Bases) const {
+  RD = RD->getDefinition();
+  if (!RD || RD->isBeingDefined() || RD->isDependentContext() ||
+      RD->isInvalidDecl())
+    return false;
+
+  llvm::DenseMap<const CXXRecordDecl*, ArrayRef<const CXXRecordDecl*> >
+    ::iterator Known = AllBaseClasses.find(RD);
+  if (Known != AllBaseClasses.end()) {
+    Bases = Known->second;
+    return true;
+  }
+
+  // Collect the direct bases and, through the cache, their own bases.
+  SmallVector<const CXXRecordDecl*, 16> Found;
+  for (CXXRecordDecl::base_class_const_iterator I = RD->bases_begin(),
+                                                E = RD->bases_end();
+       I != E; ++I) {
+    const RecordType *Ty = I->getType()->getAs<RecordType>();
+    if (!Ty)
+      return false;
+    const CXXRecordDecl *Base = cast<CXXRecordDecl>(Ty->getDecl());
+    ArrayRef<const CXXRecordDecl*> BaseBases;
+    if (!getAllBaseClasses(Base, BaseBases))
+      return false;
+    Found.push_back(Base->getCanonicalDecl());
+    Found.append(BaseBases.begin(), BaseBases.end());
+  }
+  std::sort(Found.begin(), Found.end());
+  Found.erase(std::unique(Found.begin(), Found.end()), Found.end());
+
+  const CXXRecordDecl **Mem = 0;
+  if (!Found.empty()) {
+    Mem = new (*this) const CXXRecordDecl*[Found.size()];
+    std::copy(Found.begin(), Found.end(), Mem);
+  }
+  Bases = ArrayRef<const CXXRecordDecl*>(Mem, Found.size());
+  AllBaseClasses[RD] = Bases;
+  return true;
+}
+
 bool CXXRecordDecl::isDerivedFrom(const CXXRecordDecl *Base) const {
+  if (getCanonicalDecl() == Base->getCanonicalDecl())
+    return false;
+
+  ArrayRef<const CXXRecordDecl*> AllBases;
+  if (getASTContext().getAllBaseClasses(this, AllBases))
+    return std::binary_search(AllBases.begin(), AllBases.end(),
+                              Base->getCanonicalDecl());
+
   CXXBasePaths Paths(/*FindAmbiguities=*/false, /*RecordPaths=*/false,
                      /*DetectVirtual=*/false);
   return isDerivedFrom(Base, Paths);
@@ -89,6 +139,14 @@ bool CXXRecordDecl::isDerivedFrom(const CXXRecordDecl *Base,
     return false;
   
   Paths.setOrigin(const_cast<CXXRecordDecl*>(this));
+
+  // Only walk the hierarchy to build the paths if there is a path to find.
+  ArrayRef<const CXXRecordDecl*> AllBases;
+  if (getASTContext().getAllBaseClasses(this, AllBases) &&
+      !std::binary_search(AllBases.begin(), AllBases.end(),
+                          Base->getCanonicalDecl()))
+    return false;
+
   return lookupInBases(&FindBaseClass,
                        const_cast<CXXRecordDecl*>(Base->getCanonicalDecl()),
                        Paths);
@@ -98,12 +156,25 @@ bool CXXRecordDecl::isVirtuallyDerivedFrom(const CXXRecordDecl *Base) const {
   if (!getNumVBases())
     return false;
 
+  if (getCanonicalDecl() == Base->getCanonicalDecl())
+    return false;
+
+  // A complete class lists all of its virtual bases, direct or not.
+  const CXXRecordDecl *Def = getDefinition();
+  if (Def && !Def->isBeingDefined() && !Def->isDependentContext()) {
+    const CXXRecordDecl *CanonBase = Base->getCanonicalDecl();
+    for (base_class_const_iterator I = Def->vbases_begin(),
+                                   E = Def->vbases_end(); I != E; ++I) {
+      const RecordType *Ty = I->getType()->getAs<RecordType>();
+      if (Ty && Ty->getDecl()->getCanonicalDecl() == CanonBase)
+        return true;
+    }
+    return false;
+  }
+
   CXXBasePaths Paths(/*FindAmbiguities=*/false, /*RecordPaths=*/false,
                      /*DetectVirtual=*/false);
 
-  if (getCanonicalDecl() == Base->getCanonicalDecl())
-    return false;
-  
   Paths.setOrigin(const_cast<CXXRecordDecl*>(this));
 
   const void *BasePtr = static_cast<const void*>(Base->getCanonicalDecl());
@@ -1467,6 +1467,13 @@ void StoredDeclsMap::DestroyAll(StoredDeclsMap *Map, bool Dependent) {
   }
 }
 
+bool StoredDeclsList::isFirstFunctionDeclaration(const NamedDecl *D) {
+  const FunctionDecl *FD = dyn_cast<FunctionDecl>(D);
+  if (const FunctionTemplateDecl *FTD = dyn_cast<FunctionTemplateDecl>(D))
+    FD = FTD->getTemplatedDecl();
+  return FD && !FD->getPreviousDecl();
+}
+
 DependentDiagnostic *DependentDiagnostic::Create(ASTContext &C,
                                                  DeclContext *Parent,
                                            const PartialDiagnostic &PDiag) {
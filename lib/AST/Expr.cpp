@@ -355,7 +355,10 @@ DeclRefExpr::DeclRefExpr(ASTContext &Ctx,
                          const TemplateArgumentListInfo *TemplateArgs,
                          QualType T, ExprValueKind VK)
   : Expr(DeclRefExprClass, T, VK, OK_Ordinary, false, false, false, false),
-    D(D), Loc(NameInfo.getLoc()), DNLoc(NameInfo.getInfo()) {
+    D(D), Loc(NameInfo.getLoc()) {
+  DeclRefExprBits.HasNameLoc = NameInfo.hasLocInfo() ? 1 : 0;
+  if (NameInfo.hasLocInfo())
+    getInternalNameLoc() = NameInfo.getInfo();
   DeclRefExprBits.HasQualifier = QualifierLoc ? 1 : 0;
   if (QualifierLoc)
     getInternalQualifierLoc() = QualifierLoc;
@@ -414,6 +417,8 @@ DeclRefExpr *DeclRefExpr::Create(ASTContext &Context,
     FoundD = 0;
 
   std::size_t Size = sizeof(DeclRefExpr);
+  if (NameInfo.hasLocInfo())
+    Size += sizeof(DeclarationNameLoc);
   if (QualifierLoc != 0)
     Size += sizeof(NestedNameSpecifierLoc);
   if (FoundD)
@@ -430,11 +435,14 @@ DeclRefExpr *DeclRefExpr::Create(ASTContext &Context,
 }
 
 DeclRefExpr *DeclRefExpr::CreateEmpty(ASTContext &Context,
+                                      bool HasNameLoc,
                                       bool HasQualifier,
                                       bool HasFoundDecl,
                                       bool HasTemplateKWAndArgsInfo,
                                       unsigned NumTemplateArgs) {
   std::size_t Size = sizeof(DeclRefExpr);
+  if (HasNameLoc)
+    Size += sizeof(DeclarationNameLoc);
   if (HasQualifier)
     Size += sizeof(NestedNameSpecifierLoc);
   if (HasFoundDecl)
@@ -1277,6 +1285,8 @@ MemberExpr *MemberExpr::Create(ASTContext &C, Expr *base, bool isarrow,
                                ExprValueKind vk,
                                ExprObjectKind ok) {
   std::size_t Size = sizeof(MemberExpr);
+  if (nameinfo.hasLocInfo())
+    Size += sizeof(DeclarationNameLoc);
 
   bool hasQualOrFound = (QualifierLoc ||
                          founddecl.getDecl() != memberdecl ||
@@ -1304,14 +1314,15 @@ MemberExpr *MemberExpr::Create(ASTContext &C, Expr *base, bool isarrow,
              QualifierLoc.getNestedNameSpecifier()->isInstantiationDependent()) 
       E->setInstantiationDependent(true);
     
-    E->HasQualifierOrFoundDecl = true;
+    E->MemberExprBits.HasQualifierOrFoundDecl = true;
 
     MemberNameQualifier *NQ = E->getMemberQualifier();
     NQ->QualifierLoc = QualifierLoc;
     NQ->FoundDecl = founddecl;
   }
 
-  E->HasTemplateKWAndArgsInfo = (targs || TemplateKWLoc.isValid());
+  E->MemberExprBits.HasTemplateKWAndArgsInfo
+    = (targs || TemplateKWLoc.isValid());
 
   if (targs) {
     bool Dependent = false;
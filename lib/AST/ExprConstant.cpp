@@ -376,6 +376,11 @@ namespace {
     /// declaration whose initializer is being evaluated, if any.
     APValue *EvaluatingDeclValue;
 
+    /// ReadEvaluatingDeclValue - Has the in-flight value of EvaluatingDecl
+    /// been read? Calls evaluated after this point may depend on it, so their
+    /// results must not be memoized.
+    bool ReadEvaluatingDeclValue;
+
     /// HasActiveDiagnostic - Was the previous diagnostic stored? If so, further
     /// notes attached to it will also be stored, otherwise they will not be.
     bool HasActiveDiagnostic;
@@ -387,14 +392,44 @@ namespace {
     
     bool IntOverflowCheckMode;
 
+    /// StepsTaken - The number of evaluation steps taken so far. Each call
+    /// and each statement in a function body costs one step. Evaluation is
+    /// abandoned once the -fconstexpr-steps budget is used up, if it is
+    /// non-zero.
+    uint64_t StepsTaken;
+
+    /// CachedSteps - The number of steps that the calls answered from the
+    /// constexpr call cache took when they were first evaluated, beyond the
+    /// one step each lookup costs.
+    uint64_t CachedSteps;
+
+    /// StartLoc - The location of the first diagnosable point of this
+    /// evaluation, used to attribute its cost.
+    SourceLocation StartLoc;
+
     EvalInfo(const ASTContext &C, Expr::EvalStatus &S,
              bool OverflowCheckMode=false)
       : Ctx(const_cast<ASTContext&>(C)), EvalStatus(S), CurrentCall(0),
         CallStackDepth(0), NextCallIndex(1),
         BottomFrame(*this, SourceLocation(), 0, 0, 0),
-        EvaluatingDecl(0), EvaluatingDeclValue(0), HasActiveDiagnostic(false),
+        EvaluatingDecl(0), EvaluatingDeclValue(0),
+        ReadEvaluatingDeclValue(false), HasActiveDiagnostic(false),
         CheckingPotentialConstantExpression(false),
-        IntOverflowCheckMode(OverflowCheckMode) {}
+        IntOverflowCheckMode(OverflowCheckMode),
+        StepsTaken(0), CachedSteps(0) {}
+
+    ~EvalInfo() {
+      // Record the cost of this top-level evaluation.
+      if (StepsTaken)
+        Ctx.noteConstantEvaluation(StepsTaken, CachedSteps, StartLoc);
+    }
+
+    /// getTotalSteps - The cost of the evaluation so far, counting the steps
+    /// saved by the constexpr call cache.
+    uint64_t getTotalSteps() const {
+      uint64_t Total = StepsTaken + CachedSteps;
+      return Total < StepsTaken ? ~uint64_t(0) : Total;
+    }
 
     void setEvaluatingDecl(const VarDecl *VD, APValue &Value) {
       EvaluatingDecl = VD;
@@ -403,11 +438,27 @@ namespace {
 
     const LangOptions &getLangOpts() const { return Ctx.getLangOpts(); }
 
+    /// Account for one step of evaluation at \p Loc. Returns false if the
+    /// step budget has been used up.
+    bool nextStep(SourceLocation Loc) {
+      if (StartLoc.isInvalid())
+        StartLoc = Loc;
+      unsigned Limit = getLangOpts().ConstexprStepLimit;
+      if (Limit && StepsTaken >= Limit) {
+        Diag(Loc, diag::note_constexpr_step_limit_exceeded) << Limit;
+        return false;
+      }
+      ++StepsTaken;
+      return true;
+    }
+
     bool CheckCallLimit(SourceLocation Loc) {
       // Don't perform any constexpr calls (other than the call we're checking)
       // when checking a potential constant expression.
       if (CheckingPotentialConstantExpression && CallStackDepth > 1)
         return false;
+      if (!nextStep(Loc))
+        return false;
       if (NextCallIndex == 0) {
         // NextCallIndex has wrapped around.
         Diag(Loc, diag::note_constexpr_call_limit_exceeded);
@@ -1458,6 +1509,7 @@ static bool EvaluateVarDeclInit(EvalInfo &Info, const Expr *E,
   // If we're currently evaluating the initializer of this declaration, use that
   // in-flight value.
   if (Info.EvaluatingDecl == VD) {
+    Info.ReadEvaluatingDeclValue = true;
     Result = *Info.EvaluatingDeclValue;
     return !Result.isUninit();
   }
@@ -2047,6 +2099,9 @@ enum EvalStmtResult {
 // Evaluate a statement.
 static EvalStmtResult EvaluateStmt(APValue &Result, EvalInfo &Info,
                                    const Stmt *S) {
+  if (!Info.nextStep(S->getLocStart()))
+    return ESR_Failed;
+
   switch (S->getStmtClass()) {
   default:
     return ESR_Failed;
@@ -2152,6 +2207,86 @@ static bool EvaluateArgs(ArrayRef<const Expr*> Args, ArgVector &ArgValues,
   return Success;
 }
 
+/// Append an encoding of the value \p V to \p Key, for use in the constexpr
+/// call cache. Returns false if the value refers to an object, and so does not
+/// have a meaning independent of the evaluation which produced it.
+static bool encodeMemoizableValue(const APValue &V, raw_ostream &Key) {
+  Key << char(V.getKind());
+  switch (V.getKind()) {
+  case APValue::Uninitialized:
+  case APValue::LValue:
+  case APValue::MemberPointer:
+  case APValue::AddrLabelDiff:
+    return false;
+  case APValue::Int:
+    Key << V.getInt().isUnsigned() << ':' << V.getInt().toString(16) << ';';
+    return true;
+  case APValue::Float:
+    Key << (const void*)&V.getFloat().getSemantics() << ':'
+        << V.getFloat().bitcastToAPInt().toString(16, false) << ';';
+    return true;
+  case APValue::ComplexInt:
+    Key << V.getComplexIntReal().toString(16) << ':'
+        << V.getComplexIntImag().toString(16) << ';';
+    return true;
+  case APValue::ComplexFloat:
+    Key << (const void*)&V.getComplexFloatReal().getSemantics() << ':'
+        << V.getComplexFloatReal().bitcastToAPInt().toString(16, false) << ':'
+        << V.getComplexFloatImag().bitcastToAPInt().toString(16, false) << ';';
+    return true;
+  case APValue::Vector:
+    Key << V.getVectorLength() << ';';
+    for (unsigned I = 0, N = V.getVectorLength(); I != N; ++I)
+      if (!encodeMemoizableValue(V.getVectorElt(I), Key))
+        return false;
+    return true;
+  case APValue::Array:
+    Key << V.getArraySize() << ':' << V.getArrayInitializedElts() << ';';
+    for (unsigned I = 0, N = V.getArrayInitializedElts(); I != N; ++I)
+      if (!encodeMemoizableValue(V.getArrayInitializedElt(I), Key))
+        return false;
+    return !V.hasArrayFiller() ||
+           encodeMemoizableValue(V.getArrayFiller(), Key);
+  case APValue::Struct:
+    Key << V.getStructNumBases() << ':' << V.getStructNumFields() << ';';
+    for (unsigned I = 0, N = V.getStructNumBases(); I != N; ++I)
+      if (!encodeMemoizableValue(V.getStructBase(I), Key))
+        return false;
+    for (unsigned I = 0, N = V.getStructNumFields(); I != N; ++I)
+      if (!encodeMemoizableValue(V.getStructField(I), Key))
+        return false;
+    return true;
+  case APValue::Union:
+    Key << (const void*)V.getUnionField() << ';';
+    return !V.getUnionField() || encodeMemoizableValue(V.getUnionValue(), Key);
+  }
+  llvm_unreachable("unknown APValue kind");
+}
+
+/// Compute the constexpr call cache key for a call to \p Callee with the
+/// given arguments. Returns false if the call cannot be memoized.
+static bool getConstexprCallCacheKey(EvalInfo &Info, const FunctionDecl *Callee,
+                                     const LValue *This,
+                                     ArrayRef<APValue> ArgValues,
+                                     SmallVectorImpl<char> &Key) {
+  // Only calls which are evaluated for their value alone can be reused: member
+  // calls depend on the object, and the speculative modes below report more
+  // than the value.
+  if (This || !Info.getLangOpts().ConstexprCallCacheSize ||
+      Info.CheckingPotentialConstantExpression ||
+      Info.getIntOverflowCheckMode() || Info.ReadEvaluatingDeclValue ||
+      Info.EvalStatus.HasSideEffects)
+    return false;
+
+  llvm::raw_svector_ostream OS(Key);
+  OS << (const void*)Callee->getCanonicalDecl() << ';';
+  for (unsigned I = 0, N = ArgValues.size(); I != N; ++I)
+    if (!encodeMemoizableValue(ArgValues[I], OS))
+      return false;
+  OS.flush();
+  return true;
+}
+
 /// Evaluate a function call.
 static bool HandleFunctionCall(SourceLocation CallLoc,
                                const FunctionDecl *Callee, const LValue *This,
@@ -2161,11 +2296,58 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
   if (!EvaluateArgs(Args, ArgValues, Info))
     return false;
 
+  // Calls to constexpr functions with literal arguments are pure, so reuse the
+  // result of an earlier evaluation of the same call if there is one. Results
+  // computed while merely folding can't stand in for a constant expression.
+  SmallString<64> Key;
+  bool Memoizable = getConstexprCallCacheKey(Info, Callee, This, ArgValues,
+                                             Key);
+  bool NeedConstantExpression = Info.EvalStatus.Diag != 0;
+  ASTContext::ConstexprCallCacheTy &Cache = Info.Ctx.getConstexprCallCache();
+  if (Memoizable) {
+    ASTContext::ConstexprCallCacheTy::iterator Pos = Cache.find(Key);
+    if (Pos != Cache.end() &&
+        (Pos->second.IsConstantExpression || !NeedConstantExpression)) {
+      // The lookup costs one step; account for the rest of the call's cost
+      // separately, so that the budget bounds the work actually done.
+      if (!Info.nextStep(CallLoc))
+        return false;
+      Info.Ctx.noteConstexprCallCacheHit();
+      uint64_t Saved = Pos->second.Steps - 1;
+      Info.CachedSteps = Info.CachedSteps > ~uint64_t(0) - Saved ?
+                           ~uint64_t(0) : Info.CachedSteps + Saved;
+      Result = Pos->second.Value;
+      return true;
+    }
+    Info.Ctx.noteConstexprCallCacheMiss();
+  }
+
+  uint64_t StepsBefore = Info.getTotalSteps();
   if (!Info.CheckCallLimit(CallLoc))
     return false;
 
-  CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
-  return EvaluateStmt(Result, Info, Body) == ESR_Returned;
+  bool Success;
+  {
+    CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
+    Success = EvaluateStmt(Result, Info, Body) == ESR_Returned;
+  }
+
+  // Only record the call if it was evaluated without producing any notes, so
+  // that a later hit does not lose a diagnostic.
+  if (Success && Memoizable && !Info.ReadEvaluatingDeclValue &&
+      !Info.EvalStatus.HasSideEffects &&
+      (!NeedConstantExpression || Info.EvalStatus.Diag->empty()) &&
+      Cache.size() < Info.getLangOpts().ConstexprCallCacheSize) {
+    SmallString<64> Unused;
+    llvm::raw_svector_ostream OS(Unused);
+    if (encodeMemoizableValue(Result, OS)) {
+      ASTContext::ConstexprCallResult &Entry = Cache[Key];
+      Entry.Value = Result;
+      Entry.IsConstantExpression = NeedConstantExpression;
+      Entry.Steps = Info.getTotalSteps() - StepsBefore;
+    }
+  }
+  return Success;
 }
 
 /// Evaluate a constructor call.
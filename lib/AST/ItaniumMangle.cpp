@@ -3209,12 +3209,15 @@ void CXXNameMangler::mangleExistingSubstitution(TemplateName tname) {
 // <substitution> ::= S <seq-id> _
 //                ::= S_
 bool CXXNameMangler::mangleSubstitution(const NamedDecl *ND) {
-  // Try one of the standard substitutions first.
-  if (mangleStandardSubstitution(ND))
+  // Check the substitutions seen so far first. Long template names repeat
+  // the same declarations many times, and a declaration that has a standard
+  // substitution is never added to the table, so the order does not matter.
+  const NamedDecl *Canon = cast<NamedDecl>(ND->getCanonicalDecl());
+  if (mangleSubstitution(reinterpret_cast<uintptr_t>(Canon)))
     return true;
 
-  ND = cast<NamedDecl>(ND->getCanonicalDecl());
-  return mangleSubstitution(reinterpret_cast<uintptr_t>(ND));
+  // Try one of the standard substitutions.
+  return mangleStandardSubstitution(ND);
 }
 
 /// \brief Determine whether the given type has any qualifiers that are
@@ -2453,6 +2453,14 @@ static bool mustSkipTailPadding(TargetCXXABI ABI, const CXXRecordDecl *RD) {
   llvm_unreachable("bad tail-padding use kind");
 }
 
+bool ASTContext::mayDiagnoseRecordLayout() const {
+  const DiagnosticsEngine &Diags = getDiagnostics();
+  return !Diags.isIgnoredEverywhere(diag::warn_padded_struct_field) ||
+         !Diags.isIgnoredEverywhere(diag::warn_padded_struct_anon_field) ||
+         !Diags.isIgnoredEverywhere(diag::warn_padded_struct_size) ||
+         !Diags.isIgnoredEverywhere(diag::warn_unnecessary_packed);
+}
+
 /// getASTRecordLayout - Get or compute information about the layout of the
 /// specified record (struct/union/class), which indicates its size and field
 /// position information.
@@ -2476,9 +2484,17 @@ ASTContext::getASTRecordLayout(const RecordDecl *D) const {
   const ASTRecordLayout *Entry = ASTRecordLayouts[D];
   if (Entry) return *Entry;
 
-  const ASTRecordLayout *NewEntry;
+  const ASTRecordLayout *NewEntry = 0;
 
-  if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D)) {
+  // A record from an AST file may come with the layout computed when the AST
+  // file was written. Use it as-is, unless laying the record out again could
+  // produce a diagnostic.
+  if (ExternalSource && D->isFromASTFile() && !mayDiagnoseRecordLayout())
+    NewEntry = ExternalSource->getStoredRecordLayout(D);
+
+  if (NewEntry) {
+    // The stored layout is complete.
+  } else if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D)) {
     EmptySubobjectMap EmptySubobjects(*this, RD);
     RecordLayoutBuilder Builder(*this, &EmptySubobjects);
     Builder.Layout(RD);
@@ -16,6 +16,8 @@
 #include "clang/Basic/LangOptions.h"
 #include "clang/Basic/TargetInfo.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MathExtras.h"
 using namespace clang;
 
 static const Builtin::Info BuiltinInfo[] = {
@@ -44,23 +46,65 @@ void Builtin::Context::InitializeTarget(const TargetInfo &Target) {
   Target.getTargetBuiltins(TSRecords, NumTSRecords);  
 }
 
-/// InitializeBuiltins - Mark the identifiers for all the builtins with their
-/// appropriate builtin ID # and mark any non-portable builtin identifiers as
-/// such.
+/// InitializeBuiltins - Build the table of builtins available in this
+/// language and hand it to the identifier table, which uses it to mark
+/// identifiers with their builtin ID # as they are created.
 void Builtin::Context::InitializeBuiltins(IdentifierTable &Table,
                                           const LangOptions& LangOpts) {
-  // Step #1: mark all target-independent builtins with their ID's.
+  // Size the table for a load factor of at most 1/2.
+  unsigned NumBuiltins = Builtin::FirstTSBuiltin + NumTSRecords;
+  NameTable.assign(llvm::NextPowerOf2(NumBuiltins * 2), 0);
+
+  // Step #1: collect all target-independent builtins with their ID's.
   for (unsigned i = Builtin::NotBuiltin+1; i != Builtin::FirstTSBuiltin; ++i)
     if (!LangOpts.NoBuiltin || !strchr(BuiltinInfo[i].Attributes, 'f')) {
       if (LangOpts.ObjC1 || 
           BuiltinInfo[i].builtin_lang != clang::OBJC_LANG)
-        Table.get(BuiltinInfo[i].Name).setBuiltinID(i);
+        addBuiltinName(BuiltinInfo[i].Name, i);
     }
 
-  // Step #2: Register target-specific builtins.
+  // Step #2: collect target-specific builtins.
   for (unsigned i = 0, e = NumTSRecords; i != e; ++i)
     if (!LangOpts.NoBuiltin || !strchr(TSRecords[i].Attributes, 'f'))
-      Table.get(TSRecords[i].Name).setBuiltinID(i+Builtin::FirstTSBuiltin);
+      addBuiltinName(TSRecords[i].Name, i+Builtin::FirstTSBuiltin);
+
+  Table.setBuiltinContext(this);
+}
+
+void Builtin::Context::addBuiltinName(StringRef Name, unsigned ID) {
+  unsigned Mask = NameTable.size() - 1;
+  unsigned Bucket = llvm::HashString(Name) & Mask;
+  unsigned Probe = 1;
+  while (NameTable[Bucket]) {
+    // Later registrations win, as they did when builtins were entered into
+    // the identifier table directly.
+    if (Name == GetRecord(NameTable[Bucket]).Name)
+      break;
+    Bucket = (Bucket + Probe++) & Mask;
+  }
+  NameTable[Bucket] = ID;
+}
+
+unsigned Builtin::Context::lookupBuiltinID(StringRef Name) const {
+  if (NameTable.empty())
+    return 0;
+
+  unsigned Mask = NameTable.size() - 1;
+  unsigned Bucket = llvm::HashString(Name) & Mask;
+  unsigned Probe = 1;
+  while (unsigned ID = NameTable[Bucket]) {
+    if (Name == GetRecord(ID).Name)
+      return ID;
+    Bucket = (Bucket + Probe++) & Mask;
+  }
+  return 0;
+}
+
+void Builtin::Context::GetAvailableBuiltinNames(
+                                SmallVectorImpl<const char *> &Names) const {
+  for (unsigned i = 0, e = NameTable.size(); i != e; ++i)
+    if (NameTable[i])
+      Names.push_back(GetRecord(NameTable[i]).Name);
 }
 
 void
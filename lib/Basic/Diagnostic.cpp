@@ -115,6 +115,7 @@ void DiagnosticsEngine::Reset() {
   DiagStates.clear();
   DiagStatePoints.clear();
   DiagStateOnPushStack.clear();
+  invalidateIgnoredEverywhere();
 
   // Create a DiagState and DiagStatePoint representing diagnostic changes
   // through command-line.
@@ -162,6 +163,33 @@ DiagnosticsEngine::GetDiagStatePointForLoc(SourceLocation L) const {
   return Pos;
 }
 
+bool DiagnosticsEngine::isIgnoredEverywhere(unsigned DiagID) const {
+  // Custom diagnostics cannot be mapped.
+  if (DiagID >= diag::DIAG_UPPER_LIMIT)
+    return false;
+
+  if (IgnoredEverywhereComputed.empty()) {
+    IgnoredEverywhereComputed.resize(diag::DIAG_UPPER_LIMIT);
+    IgnoredEverywhere.resize(diag::DIAG_UPPER_LIMIT);
+  }
+
+  if (!IgnoredEverywhereComputed[DiagID]) {
+    IgnoredEverywhere[DiagID] = Diags->isIgnoredInAllStates(DiagID, *this);
+    IgnoredEverywhereComputed.set(DiagID);
+  }
+  return IgnoredEverywhere[DiagID];
+}
+
+void DiagnosticsEngine::noteIgnoredEverywhereNewState(
+    diag::kind Diag, DiagnosticMappingInfo Info) {
+  // The states that were already there are unchanged, so a diagnostic that
+  // was enabled somewhere stays enabled somewhere; one that was ignored
+  // everywhere stays so only if the new state ignores it too.
+  if (Diag < IgnoredEverywhereComputed.size() &&
+      IgnoredEverywhereComputed[Diag] && IgnoredEverywhere[Diag])
+    IgnoredEverywhere[Diag] = Diags->isIgnoredMapping(Diag, Info, *this);
+}
+
 void DiagnosticsEngine::setDiagnosticMapping(diag::kind Diag, diag::Mapping Map,
                                              SourceLocation L) {
   assert(Diag < diag::DIAG_UPPER_LIMIT &&
@@ -186,6 +214,7 @@ void DiagnosticsEngine::setDiagnosticMapping(diag::kind Diag, diag::Mapping Map,
   // Common case; setting all the diagnostics of a group in one place.
   if (Loc.isInvalid() || Loc == LastStateChangePos) {
     GetCurDiagState()->setMappingInfo(Diag, MappingInfo);
+    invalidateIgnoredEverywhere(Diag);
     return;
   }
 
@@ -199,11 +228,13 @@ void DiagnosticsEngine::setDiagnosticMapping(diag::kind Diag, diag::Mapping Map,
     DiagStates.push_back(*GetCurDiagState());
     PushDiagStatePoint(&DiagStates.back(), Loc);
     GetCurDiagState()->setMappingInfo(Diag, MappingInfo);
+    noteIgnoredEverywhereNewState(Diag, MappingInfo);
     return;
   }
 
   // We allow setting the diagnostic state in random source order for
   // completeness but it should not be actually happening in normal practice.
+  invalidateIgnoredEverywhere(Diag);
 
   DiagStatePointsTy::iterator Pos = GetDiagStatePointForLoc(Loc);
   assert(Pos != DiagStatePoints.end());
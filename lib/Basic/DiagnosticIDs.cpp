@@ -393,9 +393,66 @@ DiagnosticIDs::getDiagnosticLevel(unsigned DiagID, SourceLocation Loc,
 
   unsigned DiagClass = getBuiltinDiagClass(DiagID);
   if (DiagClass == CLASS_NOTE) return DiagnosticIDs::Note;
+
+  // Most off-by-default warnings are never enabled anywhere in the
+  // translation unit; answer those without looking up the state for Loc.
+  if (DiagClass != CLASS_ERROR && Diag.isIgnoredEverywhere(DiagID))
+    return DiagnosticIDs::Ignored;
+
   return getDiagnosticLevel(DiagID, DiagClass, Loc, Diag);
 }
 
+/// \brief Determine whether the given builtin diagnostic maps to "ignored" in
+/// every DiagState of \p Diag.
+///
+/// This mirrors the location-independent part of getDiagnosticLevel. Anything
+/// that only depends on the location (system headers) or on transient state
+/// (__extension__ blocks) can only lower the level further, so it is safe to
+/// leave out here.
+bool DiagnosticIDs::isIgnoredInAllStates(unsigned DiagID,
+                                         const DiagnosticsEngine &Diag) const {
+  assert(DiagID < diag::DIAG_UPPER_LIMIT && "Can only query builtin diags");
+  if (getBuiltinDiagClass(DiagID) == CLASS_ERROR)
+    return false;
+
+  for (DiagnosticsEngine::DiagStatePointsTy::iterator
+         I = Diag.DiagStatePoints.begin(), E = Diag.DiagStatePoints.end();
+         I != E; ++I) {
+    if (!isIgnoredMapping(DiagID,
+                          I->State->getOrAddMappingInfo((diag::kind)DiagID),
+                          Diag))
+      return false;
+  }
+
+  return true;
+}
+
+bool DiagnosticIDs::isIgnoredMapping(unsigned DiagID,
+                                     DiagnosticMappingInfo MappingInfo,
+                                     const DiagnosticsEngine &Diag) const {
+  bool EnabledByDefault = false;
+  bool IsExtensionDiag = isBuiltinExtensionDiag(DiagID, EnabledByDefault);
+
+  switch (MappingInfo.getMapping()) {
+  case diag::MAP_IGNORE:
+    // -Weverything and -pedantic can upgrade ignored diagnostics that
+    // weren't explicitly mapped by the user.
+    return MappingInfo.isUser() ||
+           (!Diag.EnableAllWarnings &&
+            (!IsExtensionDiag ||
+             Diag.ExtBehavior == DiagnosticsEngine::Ext_Ignore));
+  case diag::MAP_WARNING:
+    // -w ignores warnings, unless -pedantic-errors upgraded them first.
+    return Diag.IgnoreAllWarnings &&
+           (!IsExtensionDiag || MappingInfo.isUser() ||
+            Diag.ExtBehavior != DiagnosticsEngine::Ext_Error);
+  case diag::MAP_ERROR:
+  case diag::MAP_FATAL:
+    return false;
+  }
+  llvm_unreachable("unknown mapping");
+}
+
 /// \brief Based on the way the client configured the Diagnostic
 /// object, classify the specified diagnostic ID into a Level, consumable by
 /// the DiagnosticClient.
@@ -41,6 +41,7 @@
 #endif
 #endif
 #if defined(LLVM_ON_UNIX)
+#include <fcntl.h>
 #include <limits.h>
 #endif
 using namespace clang;
@@ -187,6 +188,7 @@ FileManager::FileManager(const FileSystemOptions &FSO)
     SeenDirEntries(64), SeenFileEntries(64), NextFileUID(0) {
   NumDirLookups = NumFileLookups = 0;
   NumDirCacheMisses = NumFileCacheMisses = 0;
+  NumFilesPrefetched = 0;
 }
 
 FileManager::~FileManager() {
@@ -557,6 +559,29 @@ getBufferForFile(StringRef Filename, std::string *ErrorStr) {
   return Result.take();
 }
 
+void FileManager::prefetchFile(const FileEntry *Entry) {
+#if defined(LLVM_ON_UNIX) && defined(POSIX_FADV_WILLNEED)
+  // If the file is already open, use the open file descriptor.
+  int FD = Entry->FD;
+  bool OwnsFD = false;
+  if (FD == -1) {
+    SmallString<128> FilePath(Entry->getName());
+    FixupRelativePath(FilePath);
+    FD = ::open(FilePath.c_str(), O_RDONLY);
+    if (FD == -1)
+      return;
+    OwnsFD = true;
+  }
+
+  // The kernel reads the file asynchronously; this doesn't block on I/O.
+  if (::posix_fadvise(FD, 0, 0, POSIX_FADV_WILLNEED) == 0)
+    ++NumFilesPrefetched;
+
+  if (OwnsFD)
+    ::close(FD);
+#endif
+}
+
 /// getStatValue - Get the 'stat' information for the specified path,
 /// using the cache to accelerate it if possible.  This returns true
 /// if the path points to a virtual file or does not exist, or returns
@@ -657,6 +682,7 @@ void FileManager::PrintStats() const {
                << NumDirCacheMisses << " dir cache misses.\n";
   llvm::errs() << NumFileLookups << " file lookups, "
                << NumFileCacheMisses << " file cache misses.\n";
+  llvm::errs() << NumFilesPrefetched << " files prefetched.\n";
 
   //llvm::errs() << PagesMapped << BytesOfPagesMapped << FSLookups;
 }
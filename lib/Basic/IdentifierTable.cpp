@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Basic/IdentifierTable.h"
+#include "clang/Basic/Builtins.h"
 #include "clang/Basic/CharInfo.h"
 #include "clang/Basic/LangOptions.h"
 #include "llvm/ADT/DenseMap.h"
@@ -74,7 +75,7 @@ ExternalIdentifierLookup::~ExternalIdentifierLookup() {}
 IdentifierTable::IdentifierTable(const LangOptions &LangOpts,
                                  IdentifierInfoLookup* externalLookup)
   : HashTable(8192), // Start with space for 8K identifiers.
-    ExternalLookup(externalLookup) {
+    ExternalLookup(externalLookup), Builtins(0), NewNames(0) {
 
   // Populate the identifier table with info about keywords for the current
   // language.
@@ -85,6 +86,25 @@ IdentifierTable::IdentifierTable(const LangOptions &LangOpts,
   get("import").setModulesImport(true);
 }
 
+void IdentifierTable::setBuiltinContext(const Builtin::Context *Context) {
+  Builtins = Context;
+  if (!Builtins)
+    return;
+
+  // Mark the identifiers we already have; new ones are marked by get().
+  for (HashTableTy::iterator I = HashTable.begin(), E = HashTable.end();
+       I != E; ++I) {
+    IdentifierInfo *II = I->getValue();
+    if (II && !II->isFromAST())
+      initializeBuiltinID(*II);
+  }
+}
+
+void IdentifierTable::initializeBuiltinID(IdentifierInfo &II) {
+  if (unsigned BuiltinID = Builtins->lookupBuiltinID(II.getName()))
+    II.setBuiltinID(BuiltinID);
+}
+
 //===----------------------------------------------------------------------===//
 // Language Keyword Implementation
 //===----------------------------------------------------------------------===//
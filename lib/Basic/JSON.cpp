@@ -0,0 +1,38 @@
+//===--- JSON.cpp - Helpers for writing JSON ------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the helpers for writing JSON.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/JSON.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+
+void clang::writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (unsigned I = 0, N = Str.size(); I != N; ++I) {
+    unsigned char C = Str[I];
+    switch (C) {
+    case '"':  OS << "\\\""; break;
+    case '\\': OS << "\\\\"; break;
+    case '\n': OS << "\\n"; break;
+    case '\t': OS << "\\t"; break;
+    default:
+      if (C < 0x20)
+        OS << "\\u00" << llvm::hexdigit(C >> 4) << llvm::hexdigit(C & 0xF);
+      else
+        OS << C;
+      break;
+    }
+  }
+  OS << '"';
+}
@@ -0,0 +1,94 @@
+//===--- TimeTrace.cpp - Hierarchical trace of compile time ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the time trace written by -ftime-trace.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/TimeTrace.h"
+#include "clang/Basic/JSON.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/ThreadLocal.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+
+static llvm::ManagedStatic<llvm::sys::ThreadLocal<TimeTrace> > ActiveTrace;
+
+TimeTrace::TimeTrace() : Epoch(getCurrentTime()) { }
+
+TimeTrace::~TimeTrace() {
+  if (getActive() == this)
+    setActive(0);
+}
+
+double TimeTrace::getCurrentTime() {
+  return llvm::TimeRecord::getCurrentTime().getWallTime();
+}
+
+TimeTrace *TimeTrace::getActive() {
+  return ActiveTrace->get();
+}
+
+void TimeTrace::setActive(TimeTrace *Trace) {
+  if (Trace)
+    ActiveTrace->set(Trace);
+  else
+    ActiveTrace->erase();
+}
+
+void TimeTrace::begin() {
+  Starts.push_back(getCurrentTime());
+}
+
+void TimeTrace::end(StringRef Name, StringRef Detail) {
+  assert(!Starts.empty() && "Region ended without having begun");
+  Event E;
+  E.Name = Name;
+  E.Start = Starts.back();
+  E.Duration = getCurrentTime() - Starts.back();
+  E.Args.push_back(std::make_pair("detail", Detail.str()));
+  Starts.pop_back();
+  Events.push_back(E);
+}
+
+void TimeTrace::write(raw_ostream &OS) const {
+  // Events are recorded as they end, so nested events come before the events
+  // that contain them; viewers reconstruct the nesting from the timestamps.
+  OS << "{\"traceEvents\":[";
+  for (unsigned I = 0, N = Events.size(); I != N; ++I) {
+    const Event &E = Events[I];
+    OS << (I ? ",\n" : "\n") << "{\"name\":";
+    writeJSONString(OS, E.Name);
+    if (!E.Category.empty()) {
+      OS << ",\"cat\":";
+      writeJSONString(OS, E.Category);
+    }
+    OS << ",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+       << llvm::format(",\"ts\":%.0f,\"dur\":%.0f", (E.Start - Epoch) * 1e6,
+                       E.Duration * 1e6)
+       << ",\"args\":{";
+    bool First = true;
+    for (unsigned A = 0, NA = E.Args.size(); A != NA; ++A, First = false) {
+      OS << (First ? "" : ",");
+      writeJSONString(OS, E.Args[A].first);
+      OS << ':';
+      writeJSONString(OS, E.Args[A].second);
+    }
+    for (unsigned A = 0, NA = E.Counts.size(); A != NA; ++A, First = false) {
+      OS << (First ? "" : ",");
+      writeJSONString(OS, E.Counts[A].first);
+      OS << ':' << E.Counts[A].second;
+    }
+    OS << "}}";
+  }
+  OS << "\n]}\n";
+}
@@ -395,6 +395,14 @@ StringRef CodeGenModule::getMangledName(GlobalDecl GD) {
   if (!Str.empty())
     return Str;
 
+  // Only the names of constructor and destructor variants and of blocks
+  // depend on more than the declaration; share the rest with the ASTContext.
+  if (!isa<CXXConstructorDecl>(ND) && !isa<CXXDestructorDecl>(ND) &&
+      !isa<BlockDecl>(ND)) {
+    Str = Context.getMangledName(ND);
+    return Str;
+  }
+
   if (!getCXXABI().getMangleContext().shouldMangleDeclName(ND)) {
     IdentifierInfo *II = ND->getIdentifier();
     assert(II && "Attempt to mangle unnamed decl.");
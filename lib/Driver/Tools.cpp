@@ -2604,6 +2604,12 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   Args.AddLastArg(CmdArgs, options::OPT_fdiagnostics_print_source_range_info);
   Args.AddLastArg(CmdArgs, options::OPT_fdiagnostics_parseable_fixits);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_report);
+  if (Args.hasArg(options::OPT_ftime_trace) && Output.isFilename()) {
+    SmallString<128> TraceFile(Output.getFilename());
+    llvm::sys::path::replace_extension(TraceFile, "json");
+    CmdArgs.push_back("-time-trace-file");
+    CmdArgs.push_back(Args.MakeArgString(TraceFile));
+  }
   Args.AddLastArg(CmdArgs, options::OPT_ftrapv);
 
   if (Arg *A = Args.getLastArg(options::OPT_ftrapv_handler_EQ)) {
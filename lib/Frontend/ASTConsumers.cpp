@@ -20,6 +20,7 @@
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/JSON.h"
 #include "clang/Basic/SourceManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Path.h"
@@ -491,3 +492,253 @@ public:
 ASTConsumer *clang::CreateASTDumperXML(raw_ostream &OS) {
   return new ASTDumpXML(OS);
 }
+
+//===----------------------------------------------------------------------===//
+/// ASTDumperJSON - Streaming, machine-readable dumping.
+
+namespace {
+class ASTDumpJSON : public ASTConsumer {
+  raw_ostream &OS;
+  ASTContext *Context;
+  std::string FilterString;
+  std::string FileFilter;
+  std::string KindFilter;
+
+  /// The presumed file name of the last location written in the current
+  /// record; the file is only written when it changes.
+  std::string LastFile;
+
+public:
+  ASTDumpJSON(raw_ostream &OS, StringRef FilterString, StringRef FileFilter,
+              StringRef KindFilter)
+    : OS(OS), Context(0), FilterString(FilterString), FileFilter(FileFilter),
+      KindFilter(KindFilter) {}
+
+  virtual void Initialize(ASTContext &Context) {
+    this->Context = &Context;
+  }
+
+  virtual bool HandleTopLevelDecl(DeclGroupRef D) {
+    for (DeclGroupRef::iterator I = D.begin(), E = D.end(); I != E; ++I)
+      HandleDecl(*I);
+    OS.flush();
+    return true;
+  }
+
+private:
+  bool hasFilter() const {
+    return !FilterString.empty() || !FileFilter.empty() || !KindFilter.empty();
+  }
+  bool filterMatches(const Decl *D) const;
+  void HandleDecl(Decl *D);
+
+  void writeString(StringRef Str);
+  void writeLocation(SourceLocation Loc);
+  void writeDecl(const Decl *D, bool WithInner = true);
+  void writeStmt(const Stmt *S);
+  void writeType(QualType T);
+};
+}
+
+/// \brief Returns the kind name of the given declaration as it is written in
+/// -ast-dump output, e.g. "CXXMethodDecl".
+static std::string getDeclKindString(const Decl *D) {
+  return std::string(D->getDeclKindName()) + "Decl";
+}
+
+bool ASTDumpJSON::filterMatches(const Decl *D) const {
+  if (!KindFilter.empty() && getDeclKindString(D) != KindFilter)
+    return false;
+
+  if (!FilterString.empty()) {
+    const NamedDecl *ND = dyn_cast<NamedDecl>(D);
+    if (!ND ||
+        ND->getQualifiedNameAsString().find(FilterString) == std::string::npos)
+      return false;
+  }
+
+  if (!FileFilter.empty()) {
+    SourceManager &SM = Context->getSourceManager();
+    PresumedLoc PLoc = SM.getPresumedLoc(SM.getExpansionLoc(D->getLocation()));
+    if (PLoc.isInvalid() ||
+        StringRef(PLoc.getFilename()).find(FileFilter) == StringRef::npos)
+      return false;
+  }
+
+  return true;
+}
+
+void ASTDumpJSON::HandleDecl(Decl *D) {
+  // Namespaces and linkage specifications can be arbitrarily large; write
+  // them as a record without children, followed by a separate record for
+  // each member, rather than buffering them all in one line.
+  bool Split = isa<NamespaceDecl>(D) || isa<LinkageSpecDecl>(D);
+  if (Split && !KindFilter.empty() && getDeclKindString(D) == KindFilter)
+    Split = false;
+
+  if (!hasFilter() || filterMatches(D)) {
+    LastFile.clear();
+    writeDecl(D, /*WithInner=*/!Split);
+    OS << '\n';
+    if (!Split)
+      return;
+  }
+
+  // Look for matching declarations nested inside this one. Declarations
+  // local to a function are only reachable through its body.
+  if (ClassTemplateDecl *CTD = dyn_cast<ClassTemplateDecl>(D))
+    D = CTD->getTemplatedDecl();
+  if (isa<FunctionDecl>(D))
+    return;
+  if (DeclContext *DC = dyn_cast<DeclContext>(D))
+    for (DeclContext::decl_iterator I = DC->decls_begin(),
+                                    E = DC->decls_end(); I != E; ++I)
+      HandleDecl(*I);
+}
+
+void ASTDumpJSON::writeString(StringRef Str) {
+  writeJSONString(OS, Str);
+}
+
+void ASTDumpJSON::writeLocation(SourceLocation Loc) {
+  if (Loc.isInvalid())
+    return;
+
+  SourceManager &SM = Context->getSourceManager();
+  PresumedLoc PLoc = SM.getPresumedLoc(SM.getExpansionLoc(Loc));
+  if (PLoc.isInvalid())
+    return;
+
+  if (LastFile != PLoc.getFilename()) {
+    LastFile = PLoc.getFilename();
+    OS << ",\"file\":";
+    writeString(LastFile);
+  }
+  OS << ",\"line\":" << PLoc.getLine() << ",\"col\":" << PLoc.getColumn();
+}
+
+void ASTDumpJSON::writeType(QualType T) {
+  writeString(T.getAsString(Context->getPrintingPolicy()));
+}
+
+void ASTDumpJSON::writeDecl(const Decl *D, bool WithInner) {
+  OS << "{\"kind\":";
+  writeString(getDeclKindString(D));
+  writeLocation(D->getLocation());
+
+  if (const NamedDecl *ND = dyn_cast<NamedDecl>(D)) {
+    OS << ",\"name\":";
+    writeString(ND->getNameAsString());
+  }
+  if (const ValueDecl *VD = dyn_cast<ValueDecl>(D)) {
+    OS << ",\"type\":";
+    writeType(VD->getType());
+  } else if (const TypedefNameDecl *TD = dyn_cast<TypedefNameDecl>(D)) {
+    OS << ",\"type\":";
+    writeType(TD->getUnderlyingType());
+  }
+  if (D->isImplicit())
+    OS << ",\"implicit\":true";
+
+  SmallVector<const Decl *, 8> InnerDecls;
+  const Stmt *InnerStmt = 0;
+  if (!WithInner) {
+    // The members follow as records of their own.
+  } else if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D)) {
+    InnerDecls.append(FD->param_begin(), FD->param_end());
+    if (FD->doesThisDeclarationHaveABody())
+      InnerStmt = FD->getBody();
+  } else if (const VarDecl *VD = dyn_cast<VarDecl>(D)) {
+    InnerStmt = VD->getInit();
+  } else if (const TemplateDecl *TD = dyn_cast<TemplateDecl>(D)) {
+    if (TD->getTemplatedDecl())
+      InnerDecls.push_back(TD->getTemplatedDecl());
+  } else if (const DeclContext *DC = dyn_cast<DeclContext>(D)) {
+    InnerDecls.append(DC->decls_begin(), DC->decls_end());
+  }
+
+  if (!InnerDecls.empty() || InnerStmt) {
+    OS << ",\"inner\":[";
+    for (unsigned I = 0, N = InnerDecls.size(); I != N; ++I) {
+      if (I)
+        OS << ',';
+      writeDecl(InnerDecls[I]);
+    }
+    if (InnerStmt) {
+      if (!InnerDecls.empty())
+        OS << ',';
+      writeStmt(InnerStmt);
+    }
+    OS << ']';
+  }
+  OS << '}';
+}
+
+void ASTDumpJSON::writeStmt(const Stmt *S) {
+  if (!S) {
+    OS << "null";
+    return;
+  }
+
+  OS << "{\"kind\":";
+  writeString(S->getStmtClassName());
+  writeLocation(S->getLocStart());
+
+  if (const Expr *E = dyn_cast<Expr>(S)) {
+    OS << ",\"type\":";
+    writeType(E->getType());
+  }
+
+  if (const DeclRefExpr *DRE = dyn_cast<DeclRefExpr>(S)) {
+    OS << ",\"ref\":";
+    writeString(DRE->getDecl()->getNameAsString());
+  } else if (const MemberExpr *ME = dyn_cast<MemberExpr>(S)) {
+    OS << ",\"member\":";
+    writeString(ME->getMemberDecl()->getNameAsString());
+    OS << ",\"arrow\":" << (ME->isArrow() ? "true" : "false");
+  } else if (const IntegerLiteral *IL = dyn_cast<IntegerLiteral>(S)) {
+    bool IsSigned = IL->getType()->isSignedIntegerType();
+    OS << ",\"value\":";
+    writeString(IL->getValue().toString(10, IsSigned));
+  } else if (const StringLiteral *SL = dyn_cast<StringLiteral>(S)) {
+    if (SL->getCharByteWidth() == 1) {
+      OS << ",\"value\":";
+      writeString(SL->getString());
+    }
+  } else if (const UnaryOperator *UO = dyn_cast<UnaryOperator>(S)) {
+    OS << ",\"opcode\":";
+    writeString(UnaryOperator::getOpcodeStr(UO->getOpcode()));
+  } else if (const BinaryOperator *BO = dyn_cast<BinaryOperator>(S)) {
+    OS << ",\"opcode\":";
+    writeString(BinaryOperator::getOpcodeStr(BO->getOpcode()));
+  } else if (const CastExpr *CE = dyn_cast<CastExpr>(S)) {
+    OS << ",\"cast\":";
+    writeString(CE->getCastKindName());
+  }
+
+  OS << ",\"inner\":[";
+  if (const DeclStmt *DS = dyn_cast<DeclStmt>(S)) {
+    for (DeclStmt::const_decl_iterator I = DS->decl_begin(),
+                                       E = DS->decl_end(); I != E; ++I) {
+      if (I != DS->decl_begin())
+        OS << ',';
+      writeDecl(*I);
+    }
+  } else {
+    bool First = true;
+    for (Stmt::const_child_range C = S->children(); C; ++C) {
+      if (!First)
+        OS << ',';
+      First = false;
+      writeStmt(*C);
+    }
+  }
+  OS << "]}";
+}
+
+ASTConsumer *clang::CreateASTDumperJSON(raw_ostream &OS,
+                                        StringRef FilterString,
+                                        StringRef FileFilter,
+                                        StringRef KindFilter) {
+  return new ASTDumpJSON(OS, FilterString, FileFilter, KindFilter);
+}
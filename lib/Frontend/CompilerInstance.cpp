@@ -15,6 +15,7 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Basic/Version.h"
 #include "clang/Frontend/ChainedDiagnosticConsumer.h"
 #include "clang/Frontend/FrontendAction.h"
@@ -30,6 +31,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
 #include "clang/Sema/Sema.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 #include "clang/Serialization/ASTReader.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Config/config.h"
@@ -414,6 +416,15 @@ void CompilerInstance::createSema(TranslationUnitKind TUKind,
                                   CodeCompleteConsumer *CompletionConsumer) {
   TheSema.reset(new Sema(getPreprocessor(), getASTContext(), getASTConsumer(),
                          TUKind, CompletionConsumer));
+  TheSema->SkipFunctionTemplateInstantiations
+    = getFrontendOpts().SkipFunctionTemplateInstantiations;
+
+  // The profiler also adds the instantiations to the time trace.
+  if (getFrontendOpts().ShowTemplateProfile ||
+      !getFrontendOpts().TemplateProfileTraceFile.empty() ||
+      !getFrontendOpts().TimeTraceFile.empty())
+    TheSema->InstantiationProfiler.reset(
+        new sema::TemplateInstantiationProfiler(getASTContext()));
 }
 
 // Output Files
@@ -683,9 +694,35 @@ bool CompilerInstance::ExecuteAction(FrontendAction &Act) {
     if (hasSourceManager())
       getSourceManager().clearIDTables();
 
-    if (Act.BeginSourceFile(*this, getFrontendOpts().Inputs[i])) {
-      Act.Execute();
-      Act.EndSourceFile();
+    OwningPtr<TimeTrace> Trace;
+    if (!getFrontendOpts().TimeTraceFile.empty()) {
+      Trace.reset(new TimeTrace);
+      TimeTrace::setActive(Trace.get());
+    }
+
+    {
+      TimeTraceScope Scope("ExecuteCompiler",
+                           getFrontendOpts().Inputs[i].getFile());
+      if (Act.BeginSourceFile(*this, getFrontendOpts().Inputs[i])) {
+        {
+          TimeTraceScope ExecuteScope("Execute");
+          Act.Execute();
+        }
+        TimeTraceScope EndScope("EndSourceFile");
+        Act.EndSourceFile();
+      }
+    }
+
+    if (Trace) {
+      TimeTrace::setActive(0);
+      std::string ErrorInfo;
+      llvm::raw_fd_ostream TraceOS(getFrontendOpts().TimeTraceFile.c_str(),
+                                   ErrorInfo);
+      if (!ErrorInfo.empty())
+        getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+          << getFrontendOpts().TimeTraceFile << ErrorInfo;
+      else
+        Trace->write(TraceOS);
     }
   }
 
@@ -766,6 +803,8 @@ static void compileModule(CompilerInstance &ImportingInstance,
                           SourceLocation ImportLoc,
                           Module *Module,
                           StringRef ModuleFileName) {
+  TimeTraceScope Trace("CompileModule", Module->getFullModuleName());
+
   llvm::LockFileManager Locked(ModuleFileName);
   switch (Locked) {
   case llvm::LockFileManager::LFS_Error:
@@ -824,6 +863,8 @@ static void compileModule(CompilerInstance &ImportingInstance,
   FrontendOpts.DisableFree = false;
   FrontendOpts.GenerateGlobalModuleIndex = false;
   FrontendOpts.Inputs.clear();
+  // The time spent building the module is part of the importer's trace.
+  FrontendOpts.TimeTraceFile.clear();
   InputKind IK = getSourceInputKindFromOptions(*Invocation->getLangOpts());
 
   // Get or create the module map that we'll use to build this module.
@@ -909,6 +950,8 @@ CompilerInstance::loadModule(SourceLocation ImportLoc,
                              ModuleIdPath Path,
                              Module::NameVisibilityKind Visibility,
                              bool IsInclusionDirective) {
+  TimeTraceScope Trace("LoadModule", Path[0].first->getName());
+
   // If we've already handled this import, just return the cached result.
   // This one-element cache is important to eliminate redundant diagnostics
   // when both the preprocessor and parser see the same import declaration.
@@ -584,6 +584,8 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
       Opts.ProgramAction = frontend::ASTDump; break;
     case OPT_ast_dump_xml:
       Opts.ProgramAction = frontend::ASTDumpXML; break;
+    case OPT_ast_dump_json:
+      Opts.ProgramAction = frontend::ASTDumpJSON; break;
     case OPT_ast_print:
       Opts.ProgramAction = frontend::ASTPrint; break;
     case OPT_ast_view:
@@ -678,6 +680,13 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.RelocatablePCH = Args.hasArg(OPT_relocatable_pch);
   Opts.ShowHelp = Args.hasArg(OPT_help);
   Opts.ShowStats = Args.hasArg(OPT_print_stats);
+  Opts.ASTMemoryStatsFile = Args.getLastArgValue(OPT_ast_memory_stats_json);
+  Opts.ShowTemplateProfile = Args.hasArg(OPT_print_template_profile);
+  Opts.SkipFunctionTemplateInstantiations
+    = Args.hasArg(OPT_skip_function_template_instantiations);
+  Opts.TemplateProfileTraceFile
+    = Args.getLastArgValue(OPT_template_profile_trace);
+  Opts.TimeTraceFile = Args.getLastArgValue(OPT_time_trace_file);
   Opts.ShowTimers = Args.hasArg(OPT_ftime_report);
   Opts.ShowVersion = Args.hasArg(OPT_version);
   Opts.ASTMergeFiles = Args.getAllArgValues(OPT_ast_merge);
@@ -687,6 +696,8 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.FixAndRecompile = Args.hasArg(OPT_fixit_recompile);
   Opts.FixToTemporaries = Args.hasArg(OPT_fixit_to_temp);
   Opts.ASTDumpFilter = Args.getLastArgValue(OPT_ast_dump_filter);
+  Opts.ASTDumpFileFilter = Args.getLastArgValue(OPT_ast_dump_file_filter);
+  Opts.ASTDumpKindFilter = Args.getLastArgValue(OPT_ast_dump_kind_filter);
   Opts.UseGlobalModuleIndex = !Args.hasArg(OPT_fno_modules_global_index);
   Opts.GenerateGlobalModuleIndex = Opts.UseGlobalModuleIndex;
   
@@ -1019,6 +1030,21 @@ static Visibility parseVisibility(Arg *arg, ArgList &args,
   return DefaultVisibility;
 }
 
+/// \brief Returns true if the given action generates code.
+static bool isCodeGenAction(frontend::ActionKind Action) {
+  switch (Action) {
+  case frontend::EmitAssembly:
+  case frontend::EmitBC:
+  case frontend::EmitLLVM:
+  case frontend::EmitLLVMOnly:
+  case frontend::EmitCodeGenOnly:
+  case frontend::EmitObj:
+    return true;
+  default:
+    return false;
+  }
+}
+
 static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
                           DiagnosticsEngine &Diags) {
   // FIXME: Cleanup per-file based stuff.
@@ -1221,7 +1247,13 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
                                                     Diags);
   Opts.ConstexprCallDepth = Args.getLastArgIntValue(OPT_fconstexpr_depth, 512,
                                                     Diags);
+  Opts.ConstexprStepLimit = Args.getLastArgIntValue(OPT_fconstexpr_steps,
+                                                    1048576, Diags);
+  Opts.ConstexprCallCacheSize
+    = Args.getLastArgIntValue(OPT_fconstexpr_cache_size, 65536, Diags);
   Opts.DelayedTemplateParsing = Args.hasArg(OPT_fdelayed_template_parsing);
+  Opts.DelayedInlineMethodParsing
+    = Args.hasArg(OPT_fdelayed_inline_method_parsing);
   Opts.NumLargeByValueCopy = Args.getLastArgIntValue(OPT_Wlarge_by_value_copy_EQ,
                                                     0, Diags);
   Opts.MSBitfields = Args.hasArg(OPT_mms_bitfields);
@@ -1241,6 +1273,8 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
                         || Args.hasArg(OPT_fdump_record_layouts);
   Opts.DumpVTableLayouts = Args.hasArg(OPT_fdump_vtable_layouts);
   Opts.SpellChecking = !Args.hasArg(OPT_fno_spell_checking);
+  Opts.TypoCorrectionBudget
+    = Args.getLastArgIntValue(OPT_ftypo_correction_budget, 0, Diags);
   Opts.NoBitFieldTypeAlign = Args.hasArg(OPT_fno_bitfield_type_align);
   Opts.SinglePrecisionConstants = Args.hasArg(OPT_cl_single_precision_constant);
   Opts.FastRelaxedMath = Args.hasArg(OPT_cl_fast_relaxed_math);
@@ -1335,6 +1369,7 @@ static void ParsePreprocessorArgs(PreprocessorOptions &Opts, ArgList &Args,
       Opts.TokenCache = A->getValue();
   else
     Opts.TokenCache = Opts.ImplicitPTHInclude;
+  Opts.PrefetchDependencyFile = Args.getLastArgValue(OPT_prefetch_dependencies);
   Opts.UsePredefines = !Args.hasArg(OPT_undef);
   Opts.DetailedRecord = Args.hasArg(OPT_detailed_preprocessing_record);
   Opts.DisablePCHValidation = Args.hasArg(OPT_fno_validate_pch);
@@ -1427,6 +1462,7 @@ static void ParsePreprocessorOutputArgs(PreprocessorOutputOptions &Opts,
   case frontend::ASTDeclList:
   case frontend::ASTDump:
   case frontend::ASTDumpXML:
+  case frontend::ASTDumpJSON:
   case frontend::ASTPrint:
   case frontend::ASTView:
   case frontend::EmitAssembly:
@@ -1528,6 +1564,15 @@ bool CompilerInvocation::CreateFromArgs(CompilerInvocation &Res,
   ParseFileSystemArgs(Res.getFileSystemOpts(), *Args);
   // FIXME: We shouldn't have to pass the DashX option around here
   InputKind DashX = ParseFrontendArgs(Res.getFrontendOpts(), *Args, Diags);
+  // The generated code would lack the definitions of the function template
+  // specializations it uses.
+  if (Res.getFrontendOpts().SkipFunctionTemplateInstantiations &&
+      isCodeGenAction(Res.getFrontendOpts().ProgramAction)) {
+    Diags.Report(diag::err_drv_argument_not_allowed_with)
+      << "-skip-function-template-instantiations"
+      << Args->getLastArg(OPT_Action_Group)->getAsString(*Args);
+    Success = false;
+  }
   Success = ParseCodeGenArgs(Res.getCodeGenOpts(), *Args, DashX, Diags)
             && Success;
   ParseHeaderSearchArgs(Res.getHeaderSearchOpts(), *Args);
@@ -1535,6 +1580,17 @@ bool CompilerInvocation::CreateFromArgs(CompilerInvocation &Res,
     ParseLangArgs(*Res.getLangOpts(), *Args, DashX, Diags);
     if (Res.getFrontendOpts().ProgramAction == frontend::RewriteObjC)
       Res.getLangOpts()->ObjCExceptions = 1;
+    // Inline method bodies parsed at the end of the translation unit see the
+    // declarations that follow the class, so name lookup and overload
+    // resolution in them may differ from the language rules. That is fine
+    // for checking, but not for generating code.
+    if (Res.getLangOpts()->DelayedInlineMethodParsing &&
+        isCodeGenAction(Res.getFrontendOpts().ProgramAction)) {
+      Diags.Report(diag::err_drv_argument_not_allowed_with)
+        << "-fdelayed-inline-method-parsing"
+        << Args->getLastArg(OPT_Action_Group)->getAsString(*Args);
+      Success = false;
+    }
   }
   // FIXME: ParsePreprocessorArgs uses the FileManager to read the contents of
   // PCH file and find the original header name. Remove the need to do that in
@@ -11,6 +11,7 @@
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclGroup.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/ChainedIncludesSource.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -21,6 +22,7 @@
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Parse/ParseAST.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
@@ -166,6 +168,8 @@ bool FrontendAction::BeginSourceFile(CompilerInstance &CI,
   setCurrentInput(Input);
   setCompilerInstance(&CI);
 
+  TimeTraceScope Trace("BeginSourceFile");
+
   StringRef InputFile = Input.getFile();
   bool HasBegunSourceFile = false;
   if (!BeginInvocation(CI))
@@ -319,9 +323,9 @@ bool FrontendAction::BeginSourceFile(CompilerInstance &CI,
       goto failure;
   }
 
-  // Initialize built-in info as long as we aren't using an external AST
-  // source.
-  if (!CI.hasASTContext() || !CI.getASTContext().getExternalSource()) {
+  // Initialize built-in info. Identifiers loaded from an external AST source
+  // keep the builtin IDs they were saved with.
+  {
     Preprocessor &PP = CI.getPreprocessor();
     PP.getBuiltinInfo().InitializeBuiltins(PP.getIdentifierTable(),
                                            PP.getLangOpts());
@@ -394,6 +398,36 @@ void FrontendAction::EndSourceFile() {
   // Finalize the action.
   EndSourceFileAction();
 
+  if (!CI.getFrontendOpts().ASTMemoryStatsFile.empty() && CI.hasASTContext()) {
+    std::string ErrorInfo;
+    llvm::raw_fd_ostream OS(CI.getFrontendOpts().ASTMemoryStatsFile.c_str(),
+                            ErrorInfo);
+    if (!ErrorInfo.empty())
+      CI.getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+        << CI.getFrontendOpts().ASTMemoryStatsFile << ErrorInfo;
+    else
+      CI.getASTContext().PrintMemoryStats(OS, /*JSON=*/true);
+  }
+
+  if (CI.hasSema() && CI.getSema().InstantiationProfiler) {
+    const sema::TemplateInstantiationProfiler &Profiler
+      = *CI.getSema().InstantiationProfiler;
+    if (CI.getFrontendOpts().ShowTemplateProfile)
+      Profiler.PrintReport(llvm::errs());
+
+    const std::string &TraceFile
+      = CI.getFrontendOpts().TemplateProfileTraceFile;
+    if (!TraceFile.empty()) {
+      std::string ErrorInfo;
+      llvm::raw_fd_ostream OS(TraceFile.c_str(), ErrorInfo);
+      if (!ErrorInfo.empty())
+        CI.getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+          << TraceFile << ErrorInfo;
+      else
+        Profiler.WriteTrace(OS);
+    }
+  }
+
   // Release the consumer and the AST, in that order since the consumer may
   // perform actions in its destructor which require the context.
   //
@@ -72,6 +72,19 @@ ASTConsumer *ASTDumpXMLAction::CreateASTConsumer(CompilerInstance &CI,
   return CreateASTDumperXML(*OS);
 }
 
+ASTConsumer *ASTDumpJSONAction::CreateASTConsumer(CompilerInstance &CI,
+                                                  StringRef InFile) {
+  raw_ostream *OS;
+  if (CI.getFrontendOpts().OutputFile.empty())
+    OS = &llvm::outs();
+  else
+    OS = CI.createDefaultOutputFile(false, InFile);
+  if (!OS) return 0;
+  const FrontendOptions &Opts = CI.getFrontendOpts();
+  return CreateASTDumperJSON(*OS, Opts.ASTDumpFilter, Opts.ASTDumpFileFilter,
+                             Opts.ASTDumpKindFilter);
+}
+
 ASTConsumer *ASTViewAction::CreateASTConsumer(CompilerInstance &CI,
                                               StringRef InFile) {
   return CreateASTViewer();
@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Frontend/Utils.h"
+#include "clang/Basic/CharInfo.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/MacroBuilder.h"
 #include "clang/Basic/SourceManager.h"
@@ -24,9 +25,14 @@
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Serialization/ASTReader.h"
 #include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 using namespace clang;
 
 // Append a #define line to Buf for Macro.  Macro should be of the form XXX,
@@ -720,31 +726,105 @@ static void InitializeFileRemapping(DiagnosticsEngine &Diags,
                                         InitOpts.RemappedFilesKeepOriginalName);
 }
 
-/// InitializePreprocessor - Initialize the preprocessor getting it and the
-/// environment ready to process a single file. This returns true on error.
+namespace {
+/// \brief Process-wide cache of the predefined macros that only depend on the
+/// target and language configuration.
 ///
-void clang::InitializePreprocessor(Preprocessor &PP,
-                                   const PreprocessorOptions &InitOpts,
-                                   const HeaderSearchOptions &HSOpts,
-                                   const FrontendOptions &FEOpts) {
-  const LangOptions &LangOpts = PP.getLangOpts();
+/// Tools that run many compilations in a single process (libclang, compile
+/// servers, refactoring tools) would otherwise regenerate the same few
+/// hundred \#defines for every translation unit.
+class PredefinesCache {
+  llvm::sys::Mutex Lock;
+  llvm::StringMap<std::string> Entries;
+  unsigned NumHits;
+
+public:
+  PredefinesCache() : NumHits(0) { }
+
+  /// \brief Look up the predefines for the configuration \p Key, returning
+  /// true and filling in \p Predefines if they are cached.
+  bool lookup(StringRef Key, std::string &Predefines) {
+    llvm::sys::ScopedLock Guard(Lock);
+    llvm::StringMap<std::string>::iterator Known = Entries.find(Key);
+    if (Known == Entries.end())
+      return false;
+    Predefines = Known->getValue();
+    ++NumHits;
+    return true;
+  }
+
+  unsigned getNumHits() {
+    llvm::sys::ScopedLock Guard(Lock);
+    return NumHits;
+  }
+
+  void insert(StringRef Key, StringRef Predefines) {
+    llvm::sys::ScopedLock Guard(Lock);
+    Entries[Key] = Predefines;
+  }
+};
+}
+
+static llvm::ManagedStatic<PredefinesCache> ConfigurationPredefines;
+
+unsigned clang::getNumCachedPredefinesHits() {
+  return ConfigurationPredefines->getNumHits();
+}
+
+/// \brief Compute a key that uniquely identifies everything the target and
+/// language predefines depend on.
+static std::string getPredefinesCacheKey(const TargetInfo &TI,
+                                         const LangOptions &LangOpts,
+                                         const FrontendOptions &FEOpts,
+                                         const PreprocessorOptions &InitOpts) {
+  std::string Key;
+  llvm::raw_string_ostream OS(Key);
+
+  const TargetOptions &TargetOpts = TI.getTargetOpts();
+  OS << TargetOpts.Triple << '\0' << TargetOpts.CPU << '\0' << TargetOpts.ABI
+     << '\0' << TargetOpts.CXXABI << '\0' << TargetOpts.LinkerVersion << '\0'
+     << TargetOpts.AMPIsKernel << '\0';
+  for (unsigned I = 0, N = TargetOpts.Features.size(); I != N; ++I)
+    OS << TargetOpts.Features[I] << '\0';
+  OS << '\0';
+
+#define LANGOPT(Name, Bits, Default, Description) \
+  OS << LangOpts.Name << ',';
+#define ENUM_LANGOPT(Name, Type, Bits, Default, Description) \
+  OS << static_cast<unsigned>(LangOpts.get##Name()) << ',';
+#include "clang/Basic/LangOptions.def"
+#define SANITIZER(NAME, ID) OS << LangOpts.Sanitize.ID;
+#include "clang/Basic/Sanitizers.def"
+  OS << '\0' << LangOpts.ObjCRuntime << '\0';
+
+  OS << FEOpts.ProgramAction << ',' << InitOpts.UsePredefines << ','
+     << InitOpts.ObjCXXARCStandardLibrary;
+  return OS.str();
+}
+
+/// \brief Add the predefined macros that only depend on the target and
+/// language configuration, reusing the text computed for an earlier
+/// translation unit with the same configuration when possible.
+static void AddConfigurationPredefines(const TargetInfo &TI,
+                                       const LangOptions &LangOpts,
+                                       const FrontendOptions &FEOpts,
+                                       const PreprocessorOptions &InitOpts,
+                                       MacroBuilder &Builder) {
+  std::string Key = getPredefinesCacheKey(TI, LangOpts, FEOpts, InitOpts);
+  std::string Cached;
+  if (ConfigurationPredefines->lookup(Key, Cached)) {
+    Builder.append(Cached);
+    return;
+  }
+
   std::string PredefineBuffer;
   PredefineBuffer.reserve(4080);
   llvm::raw_string_ostream Predefines(PredefineBuffer);
-  MacroBuilder Builder(Predefines);
-
-  InitializeFileRemapping(PP.getDiagnostics(), PP.getSourceManager(),
-                          PP.getFileManager(), InitOpts);
-
-  // Emit line markers for various builtin sections of the file.  We don't do
-  // this in asm preprocessor mode, because "# 4" is not a line marker directive
-  // in this mode.
-  if (!PP.getLangOpts().AsmPreprocessor)
-    Builder.append("# 1 \"<built-in>\" 3");
+  MacroBuilder ConfigBuilder(Predefines);
 
   // Install things like __POWERPC__, __GNUC__, etc into the macro table.
   if (InitOpts.UsePredefines) {
-    InitializePredefinedMacros(PP.getTargetInfo(), LangOpts, FEOpts, Builder);
+    InitializePredefinedMacros(TI, LangOpts, FEOpts, ConfigBuilder);
 
     // Install definitions to make Objective-C++ ARC work well with various
     // C++ Standard Library implementations.
@@ -755,7 +835,7 @@ void clang::InitializePreprocessor(Preprocessor &PP,
         break;
 
       case ARCXX_libstdcxx:
-        AddObjCXXARCLibstdcxxDefines(LangOpts, Builder);
+        AddObjCXXARCLibstdcxxDefines(LangOpts, ConfigBuilder);
         break;
       }
     }
@@ -764,8 +844,91 @@ void clang::InitializePreprocessor(Preprocessor &PP,
   // Even with predefines off, some macros are still predefined.
   // These should all be defined in the preprocessor according to the
   // current language configuration.
-  InitializeStandardPredefinedMacros(PP.getTargetInfo(), PP.getLangOpts(),
-                                     FEOpts, Builder);
+  InitializeStandardPredefinedMacros(TI, LangOpts, FEOpts, ConfigBuilder);
+
+  // MacroBuilder::append adds a newline of its own.
+  StringRef Result = Predefines.str();
+  if (Result.endswith("\n"))
+    Result = Result.drop_back();
+  ConfigurationPredefines->insert(Key, Result);
+  Builder.append(Result);
+}
+
+/// \brief Prefetch the files listed in a make-style dependency file, such as
+/// the one written by -MD when this translation unit was last compiled.
+///
+/// A missing or malformed file is silently ignored; this is only a hint.
+static void PrefetchDependencies(FileManager &FileMgr, StringRef DepFile) {
+  OwningPtr<llvm::MemoryBuffer> Buffer(FileMgr.getBufferForFile(DepFile));
+  if (!Buffer)
+    return;
+
+  StringRef Contents = Buffer->getBuffer();
+  std::string Path;
+  for (unsigned I = 0, N = Contents.size(); I <= N; ++I) {
+    char C = I < N ? Contents[I] : ' ';
+    if (C == '\\' && I + 1 < N) {
+      // A backslash either continues the line or escapes a space.
+      char Next = Contents[I + 1];
+      if (Next == '\n' || Next == '\r') {
+        ++I;
+        continue;
+      }
+      if (Next == ' ' || Next == '#' || Next == '\\') {
+        Path += Next;
+        ++I;
+        continue;
+      }
+    } else if (C == '$' && I + 1 < N && Contents[I + 1] == '$') {
+      Path += '$';
+      ++I;
+      continue;
+    }
+
+    if (!isWhitespace(C)) {
+      Path += C;
+      continue;
+    }
+
+    // Skip the target(s) of each rule.
+    if (!Path.empty() && Path[Path.size() - 1] != ':')
+      if (const FileEntry *File = FileMgr.getFile(Path, /*openFile=*/false))
+        FileMgr.prefetchFile(File);
+    Path.clear();
+  }
+}
+
+/// InitializePreprocessor - Initialize the preprocessor getting it and the
+/// environment ready to process a single file. This returns true on error.
+///
+void clang::InitializePreprocessor(Preprocessor &PP,
+                                   const PreprocessorOptions &InitOpts,
+                                   const HeaderSearchOptions &HSOpts,
+                                   const FrontendOptions &FEOpts) {
+  const LangOptions &LangOpts = PP.getLangOpts();
+  std::string PredefineBuffer;
+  PredefineBuffer.reserve(4080);
+  llvm::raw_string_ostream Predefines(PredefineBuffer);
+  MacroBuilder Builder(Predefines);
+
+  InitializeFileRemapping(PP.getDiagnostics(), PP.getSourceManager(),
+                          PP.getFileManager(), InitOpts);
+
+  // Start reading the headers we expect to need while we set everything else
+  // up.
+  if (!InitOpts.PrefetchDependencyFile.empty())
+    PrefetchDependencies(PP.getFileManager(), InitOpts.PrefetchDependencyFile);
+
+  // Emit line markers for various builtin sections of the file.  We don't do
+  // this in asm preprocessor mode, because "# 4" is not a line marker directive
+  // in this mode.
+  if (!PP.getLangOpts().AsmPreprocessor)
+    Builder.append("# 1 \"<built-in>\" 3");
+
+  // Install things like __POWERPC__, __GNUC__, __STDC__, etc into the macro
+  // table.
+  AddConfigurationPredefines(PP.getTargetInfo(), LangOpts, FEOpts, InitOpts,
+                             Builder);
 
   // Add on the predefines from the driver.  Wrap in a #line directive to report
   // that they come from the command line.
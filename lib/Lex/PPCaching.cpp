@@ -40,6 +40,8 @@ void Preprocessor::CommitBacktrackedTokens() {
 void Preprocessor::Backtrack() {
   assert(!BacktrackPositions.empty()
          && "EnableBacktrackAtThisPos was not called!");
+  if (CachedLexPos > BacktrackPositions.back())
+    NumBacktrackedTokens += CachedLexPos - BacktrackPositions.back();
   CachedLexPos = BacktrackPositions.back();
   BacktrackPositions.pop_back();
   recomputeCurLexerKind();
@@ -63,13 +63,9 @@ PreprocessingRecord::getPreprocessedEntitiesInRange(SourceRange Range) {
   return std::make_pair(iterator(this, Res.first), iterator(this, Res.second));
 }
 
-static bool isPreprocessedEntityIfInFileID(PreprocessedEntity *PPE, FileID FID,
-                                           SourceManager &SM) {
+static bool isLocationInFileID(SourceLocation Loc, FileID FID,
+                               SourceManager &SM) {
   assert(!FID.isInvalid());
-  if (!PPE)
-    return false;
-
-  SourceLocation Loc = PPE->getSourceRange().getBegin();
   if (Loc.isInvalid())
     return false;
   
@@ -79,6 +75,14 @@ static bool isPreprocessedEntityIfInFileID(PreprocessedEntity *PPE, FileID FID,
     return false;
 }
 
+static bool isPreprocessedEntityIfInFileID(PreprocessedEntity *PPE, FileID FID,
+                                           SourceManager &SM) {
+  if (!PPE)
+    return false;
+
+  return isLocationInFileID(PPE->getSourceRange().getBegin(), FID, SM);
+}
+
 /// \brief Returns true if the preprocessed entity that \arg PPEI iterator
 /// points to is coming from the file \arg FID.
 ///
@@ -119,8 +123,10 @@ bool PreprocessingRecord::isEntityInFileID(iterator PPEI, FileID FID) {
     assert(0 && "Out-of bounds local preprocessed entity");
     return false;
   }
-  return isPreprocessedEntityIfInFileID(PreprocessedEntities[Pos],
-                                        FID, SourceMgr);
+  // Local entities keep their ranges apart, so there is no need to
+  // materialize the entity.
+  return isLocationInFileID(PreprocessedEntityRanges[Pos].getBegin(),
+                            FID, SourceMgr);
 }
 
 /// \brief Returns a pair of [Begin, End) iterators of preprocessed entities
@@ -175,24 +181,23 @@ struct PPEntityComp {
 
   explicit PPEntityComp(const SourceManager &SM) : SM(SM) { }
 
-  bool operator()(PreprocessedEntity *L, PreprocessedEntity *R) const {
+  bool operator()(SourceRange L, SourceRange R) const {
     SourceLocation LHS = getLoc(L);
     SourceLocation RHS = getLoc(R);
     return SM.isBeforeInTranslationUnit(LHS, RHS);
   }
 
-  bool operator()(PreprocessedEntity *L, SourceLocation RHS) const {
+  bool operator()(SourceRange L, SourceLocation RHS) const {
     SourceLocation LHS = getLoc(L);
     return SM.isBeforeInTranslationUnit(LHS, RHS);
   }
 
-  bool operator()(SourceLocation LHS, PreprocessedEntity *R) const {
+  bool operator()(SourceLocation LHS, SourceRange R) const {
     SourceLocation RHS = getLoc(R);
     return SM.isBeforeInTranslationUnit(LHS, RHS);
   }
 
-  SourceLocation getLoc(PreprocessedEntity *PPE) const {
-    SourceRange Range = PPE->getSourceRange();
+  SourceLocation getLoc(SourceRange Range) const {
     return (Range.*getRangeLoc)();
   }
 };
@@ -204,11 +209,11 @@ unsigned PreprocessingRecord::findBeginLocalPreprocessedEntity(
   if (SourceMgr.isLoadedSourceLocation(Loc))
     return 0;
 
-  size_t Count = PreprocessedEntities.size();
+  size_t Count = PreprocessedEntityRanges.size();
   size_t Half;
-  std::vector<PreprocessedEntity *>::const_iterator
-    First = PreprocessedEntities.begin();
-  std::vector<PreprocessedEntity *>::const_iterator I;
+  std::vector<SourceRange>::const_iterator
+    First = PreprocessedEntityRanges.begin();
+  std::vector<SourceRange>::const_iterator I;
 
   // Do a binary search manually instead of using std::lower_bound because
   // The end locations of entities may be unordered (when a macro expansion
@@ -218,8 +223,7 @@ unsigned PreprocessingRecord::findBeginLocalPreprocessedEntity(
     Half = Count/2;
     I = First;
     std::advance(I, Half);
-    if (SourceMgr.isBeforeInTranslationUnit((*I)->getSourceRange().getEnd(),
-                                            Loc)){
+    if (SourceMgr.isBeforeInTranslationUnit(I->getEnd(), Loc)) {
       First = I;
       ++First;
       Count = Count - Half - 1;
@@ -227,7 +231,7 @@ unsigned PreprocessingRecord::findBeginLocalPreprocessedEntity(
       Count = Half;
   }
 
-  return First - PreprocessedEntities.begin();
+  return First - PreprocessedEntityRanges.begin();
 }
 
 unsigned PreprocessingRecord::findEndLocalPreprocessedEntity(
@@ -235,33 +239,41 @@ unsigned PreprocessingRecord::findEndLocalPreprocessedEntity(
   if (SourceMgr.isLoadedSourceLocation(Loc))
     return 0;
 
-  std::vector<PreprocessedEntity *>::const_iterator
-  I = std::upper_bound(PreprocessedEntities.begin(),
-                       PreprocessedEntities.end(),
+  std::vector<SourceRange>::const_iterator
+  I = std::upper_bound(PreprocessedEntityRanges.begin(),
+                       PreprocessedEntityRanges.end(),
                        Loc,
                        PPEntityComp<&SourceRange::getBegin>(SourceMgr));
-  return I - PreprocessedEntities.begin();
+  return I - PreprocessedEntityRanges.begin();
 }
 
 PreprocessingRecord::PPEntityID
 PreprocessingRecord::addPreprocessedEntity(PreprocessedEntity *Entity) {
   assert(Entity);
-  SourceLocation BeginLoc = Entity->getSourceRange().getBegin();
+  return addLocalEntity(Entity->getSourceRange(), LocalEntityRef(Entity));
+}
+
+PreprocessingRecord::PPEntityID
+PreprocessingRecord::addLocalEntity(SourceRange Range, LocalEntityRef Ref) {
+  SourceLocation BeginLoc = Range.getBegin();
 
-  if (isa<MacroDefinition>(Entity)) {
-    assert((PreprocessedEntities.empty() ||
+  if (Ref.is<PreprocessedEntity *>() &&
+      isa<MacroDefinition>(Ref.get<PreprocessedEntity *>())) {
+    assert((PreprocessedEntityRanges.empty() ||
             !SourceMgr.isBeforeInTranslationUnit(BeginLoc,
-                   PreprocessedEntities.back()->getSourceRange().getBegin())) &&
+                   PreprocessedEntityRanges.back().getBegin())) &&
            "a macro definition was encountered out-of-order");
-    PreprocessedEntities.push_back(Entity);
+    PreprocessedEntityRanges.push_back(Range);
+    PreprocessedEntities.push_back(Ref);
     return getPPEntityID(PreprocessedEntities.size()-1, /*isLoaded=*/false);
   }
 
   // Check normal case, this entity begin location is after the previous one.
-  if (PreprocessedEntities.empty() ||
+  if (PreprocessedEntityRanges.empty() ||
       !SourceMgr.isBeforeInTranslationUnit(BeginLoc,
-                   PreprocessedEntities.back()->getSourceRange().getBegin())) {
-    PreprocessedEntities.push_back(Entity);
+                   PreprocessedEntityRanges.back().getBegin())) {
+    PreprocessedEntityRanges.push_back(Range);
+    PreprocessedEntities.push_back(Ref);
     return getPPEntityID(PreprocessedEntities.size()-1, /*isLoaded=*/false);
   }
 
@@ -277,32 +289,36 @@ PreprocessingRecord::addPreprocessedEntity(PreprocessedEntity *Entity) {
   //  FM(M1, M2)
   // \endcode
 
-  typedef std::vector<PreprocessedEntity *>::iterator pp_iter;
+  typedef std::vector<SourceRange>::iterator range_iter;
 
   // Usually there are few macro expansions when defining the filename, do a
   // linear search for a few entities.
+  range_iter InsertPos = PreprocessedEntityRanges.begin();
+  bool Found = false;
   unsigned count = 0;
-  for (pp_iter RI    = PreprocessedEntities.end(),
-               Begin = PreprocessedEntities.begin();
+  for (range_iter RI    = PreprocessedEntityRanges.end(),
+                  Begin = PreprocessedEntityRanges.begin();
        RI != Begin && count < 4; --RI, ++count) {
-    pp_iter I = RI;
+    range_iter I = RI;
     --I;
-    if (!SourceMgr.isBeforeInTranslationUnit(BeginLoc,
-                                           (*I)->getSourceRange().getBegin())) {
-      pp_iter insertI = PreprocessedEntities.insert(RI, Entity);
-      return getPPEntityID(insertI - PreprocessedEntities.begin(),
-                           /*isLoaded=*/false);
+    if (!SourceMgr.isBeforeInTranslationUnit(BeginLoc, I->getBegin())) {
+      InsertPos = RI;
+      Found = true;
+      break;
     }
   }
 
   // Linear search unsuccessful. Do a binary search.
-  pp_iter I = std::upper_bound(PreprocessedEntities.begin(),
-                               PreprocessedEntities.end(),
-                               BeginLoc,
+  if (!Found)
+    InsertPos = std::upper_bound(PreprocessedEntityRanges.begin(),
+                                 PreprocessedEntityRanges.end(),
+                                 BeginLoc,
                                PPEntityComp<&SourceRange::getBegin>(SourceMgr));
-  pp_iter insertI = PreprocessedEntities.insert(I, Entity);
-  return getPPEntityID(insertI - PreprocessedEntities.begin(),
-                       /*isLoaded=*/false);
+
+  unsigned Index = InsertPos - PreprocessedEntityRanges.begin();
+  PreprocessedEntityRanges.insert(InsertPos, Range);
+  PreprocessedEntities.insert(PreprocessedEntities.begin() + Index, Ref);
+  return getPPEntityID(Index, /*isLoaded=*/false);
 }
 
 void PreprocessingRecord::SetExternalSource(
@@ -338,7 +354,7 @@ PreprocessedEntity *PreprocessingRecord::getPreprocessedEntity(PPEntityID PPID){
   unsigned Index = PPID.ID - 1;
   assert(Index < PreprocessedEntities.size() &&
          "Out-of bounds local preprocessed entity");
-  return PreprocessedEntities[Index];
+  return getLocalPreprocessedEntity(Index);
 }
 
 /// \brief Retrieve the loaded preprocessed entity at the given index.
@@ -357,6 +373,23 @@ PreprocessingRecord::getLoadedPreprocessedEntity(unsigned Index) {
   return Entity;
 }
 
+/// \brief Retrieve the local preprocessed entity at the given index.
+PreprocessedEntity *
+PreprocessingRecord::getLocalPreprocessedEntity(unsigned Index) {
+  assert(Index < PreprocessedEntities.size() &&
+         "Out-of bounds local preprocessed entity");
+  LocalEntityRef &Ref = PreprocessedEntities[Index];
+  if (PreprocessedEntity *Entity = Ref.dyn_cast<PreprocessedEntity *>())
+    return Entity;
+
+  // A macro expansion stored in compact form; build the entity on first use.
+  PreprocessedEntity *Expansion
+    = new (*this) MacroExpansion(Ref.get<MacroDefinition *>(),
+                                 PreprocessedEntityRanges[Index]);
+  Ref = Expansion;
+  return Expansion;
+}
+
 MacroDefinition *PreprocessingRecord::findMacroDefinition(const MacroInfo *MI) {
   llvm::DenseMap<const MacroInfo *, PPEntityID>::iterator Pos
     = MacroDefinitions.find(MI);
@@ -380,8 +413,7 @@ void PreprocessingRecord::addMacroExpansion(const Token &Id,
     addPreprocessedEntity(
                       new (*this) MacroExpansion(Id.getIdentifierInfo(),Range));
   else if (MacroDefinition *Def = findMacroDefinition(MI))
-    addPreprocessedEntity(
-                       new (*this) MacroExpansion(Def, Range));
+    addLocalEntity(Range, LocalEntityRef(Def));
 }
 
 void PreprocessingRecord::Ifdef(SourceLocation Loc, const Token &MacroNameTok,
@@ -477,6 +509,7 @@ void PreprocessingRecord::InclusionDirective(
 size_t PreprocessingRecord::getTotalMemory() const {
   return BumpAlloc.getTotalMemory()
     + llvm::capacity_in_bytes(MacroDefinitions)
+    + llvm::capacity_in_bytes(PreprocessedEntityRanges)
     + llvm::capacity_in_bytes(PreprocessedEntities)
     + llvm::capacity_in_bytes(LoadedPreprocessedEntities);
 }
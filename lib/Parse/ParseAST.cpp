@@ -17,6 +17,7 @@
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/ExternalASTSource.h"
 #include "clang/AST/Stmt.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Parse/ParseDiagnostic.h"
 #include "clang/Parse/Parser.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
@@ -85,6 +86,20 @@ void clang::ParseAST(Preprocessor &PP, ASTConsumer *Consumer,
   ParseAST(*S.get(), PrintStats, SkipFunctionBodies);
 }
 
+/// \brief Parse the next top-level declaration, recording the time it takes
+/// in the time trace.
+static bool parseTopLevelDecl(Parser &P, Parser::DeclGroupPtrTy &Result) {
+  TimeTraceScope Trace("ParseTopLevelDecl");
+  bool AtEOF = P.ParseTopLevelDecl(Result);
+  if (Trace.isActive() && Result) {
+    DeclGroupRef DG = Result.get();
+    if (DG.begin() != DG.end())
+      if (NamedDecl *ND = dyn_cast<NamedDecl>(*DG.begin()))
+        Trace.setDetail(ND->getQualifiedNameAsString());
+  }
+  return AtEOF;
+}
+
 void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
   // Collect global stats on Decls/Stmts (until we have a module streamer).
   if (PrintStats) {
@@ -120,7 +135,7 @@ void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
   if (External)
     External->StartTranslationUnit(Consumer);
 
-  if (P.ParseTopLevelDecl(ADecl)) {
+  if (parseTopLevelDecl(P, ADecl)) {
     if (!External && !S.getLangOpts().CPlusPlus)
       P.Diag(diag::ext_empty_translation_unit);
   } else {
@@ -128,9 +143,12 @@ void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
       // If we got a null return and something *was* parsed, ignore it.  This
       // is due to a top-level semicolon, an action override, or a parse error
       // skipping something.
-      if (ADecl && !Consumer->HandleTopLevelDecl(ADecl.get()))
-        return;
-    } while (!P.ParseTopLevelDecl(ADecl));
+      if (ADecl) {
+        TimeTraceScope Trace("HandleTopLevelDecl");
+        if (!Consumer->HandleTopLevelDecl(ADecl.get()))
+          return;
+      }
+    } while (!parseTopLevelDecl(P, ADecl));
   }
 
   // Process any TopLevelDecls generated by #pragma weak.
@@ -139,13 +157,18 @@ void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
        E = S.WeakTopLevelDecls().end(); I != E; ++I)
     Consumer->HandleTopLevelDecl(DeclGroupRef(*I));
   
-  Consumer->HandleTranslationUnit(S.getASTContext());
+  {
+    TimeTraceScope Trace("HandleTranslationUnit");
+    Consumer->HandleTranslationUnit(S.getASTContext());
+  }
 
   std::swap(OldCollectStats, S.CollectStats);
   if (PrintStats) {
     llvm::errs() << "\nSTATISTICS:\n";
+    P.PrintStats();
     P.getActions().PrintStats();
     S.getASTContext().PrintStats();
+    S.getASTContext().PrintMemoryStats(llvm::errs());
     Decl::PrintStats();
     Stmt::PrintStats();
     Consumer->PrintStats();
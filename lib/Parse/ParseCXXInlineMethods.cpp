@@ -135,6 +135,30 @@ NamedDecl *Parser::ParseCXXInlineMethodDef(AccessSpecifier AS,
     return FnD;
   }
 
+  // In delayed inline method parsing mode, store the tokens of the body of
+  // an inline method of an ordinary class, and only parse it at the end of
+  // the translation unit if the method turns out to be used. Constexpr
+  // functions are needed for constant evaluation, and bodies in local
+  // classes and translation unit prefixes cannot be parsed later.
+  if (getLangOpts().DelayedInlineMethodParsing &&
+      Actions.TUKind == TU_Complete &&
+      DefinitionKind == FDK_Definition &&
+      TemplateInfo.Kind == ParsedTemplateInfo::NonTemplate &&
+      !D.getDeclSpec().isFriendSpecified() &&
+      !D.getDeclSpec().isConstexprSpecified() &&
+      !Actions.CurContext->isDependentContext() &&
+      !cast<Decl>(Actions.CurContext)->getParentFunctionOrMethod() &&
+      FnD && isa<CXXMethodDecl>(FnD)) {
+    LateParsedTemplatedFunction *LPT = new LateParsedTemplatedFunction(FnD);
+    FunctionDecl *FD = cast<FunctionDecl>(FnD);
+    Actions.CheckForFunctionRedefinition(FD);
+
+    LateParsedTemplateMap[FD] = LPT;
+    LexTemplateFunctionForLateParsing(LPT->Toks);
+    Actions.MarkAsLateParsedInlineMethod(FD, LPT->Toks);
+    return FnD;
+  }
+
   // Consume the tokens and store them for later parsing.
 
   LexedMethod* LM = new LexedMethod(this, FnD);
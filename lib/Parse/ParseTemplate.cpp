@@ -1321,6 +1321,7 @@ void Parser::ParseLateTemplatedFuncDef(LateParsedTemplatedFunction &LMT) {
 
   if (Tok.is(tok::kw_try)) {
     ParseFunctionTryBlock(LMT.D, FnScope);
+    Actions.MarkAsLateParsedTemplate(FD, false);
   } else {
     if (Tok.is(tok::colon))
       ParseConstructorInitializer(LMT.D);
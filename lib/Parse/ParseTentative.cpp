@@ -126,19 +126,29 @@ bool Parser::isCXXSimpleDeclaration(bool AllowForRangeDecl) {
   // or an identifier which doesn't resolve as anything. We need tentative
   // parsing...
 
+  TentativeQueryKey Key;
+  bool Memoize = getTentativeQueryKey(AllowForRangeDecl ? TQ_ForRangeDeclaration
+                                                        : TQ_SimpleDeclaration,
+                                      Key);
+  bool Result, IsAmbiguous;
+  if (Memoize && getCachedTentativeQuery(Key, Result, IsAmbiguous))
+    return Result;
+
   TentativeParsingAction PA(*this);
   TPR = TryParseSimpleDeclaration(AllowForRangeDecl);
   PA.Revert();
 
   // In case of an error, let the declaration parsing code handle it.
   if (TPR == TPResult::Error())
-    return true;
+    TPR = TPResult::True();
 
   // Declarations take precedence over expressions.
   if (TPR == TPResult::Ambiguous())
     TPR = TPResult::True();
 
   assert(TPR == TPResult::True() || TPR == TPResult::False());
+  if (Memoize)
+    cacheTentativeQuery(Key, TPR == TPResult::True(), false);
   return TPR == TPResult::True();
 }
 
@@ -269,6 +279,12 @@ bool Parser::isCXXConditionDeclaration() {
   // Ok, we have a simple-type-specifier/typename-specifier followed by a '('.
   // We need tentative parsing...
 
+  TentativeQueryKey Key;
+  bool Memoize = getTentativeQueryKey(TQ_ConditionDeclaration, Key);
+  bool Result, IsAmbiguous;
+  if (Memoize && getCachedTentativeQuery(Key, Result, IsAmbiguous))
+    return Result;
+
   TentativeParsingAction PA(*this);
 
   // type-specifier-seq
@@ -304,6 +320,8 @@ bool Parser::isCXXConditionDeclaration() {
   PA.Revert();
 
   assert(TPR == TPResult::True() || TPR == TPResult::False());
+  if (Memoize)
+    cacheTentativeQuery(Key, TPR == TPResult::True(), false);
   return TPR == TPResult::True();
 }
 
@@ -346,6 +364,15 @@ bool Parser::isCXXTypeId(TentativeCXXTypeIdContext Context, bool &isAmbiguous) {
   // Ok, we have a simple-type-specifier/typename-specifier followed by a '('.
   // We need tentative parsing...
 
+  TentativeQueryKey Key;
+  bool Memoize = getTentativeQueryKey(Context == TypeIdInParens
+                                        ? TQ_TypeIdInParens
+                                        : TQ_TypeIdAsTemplateArgument,
+                                      Key);
+  bool Result;
+  if (Memoize && getCachedTentativeQuery(Key, Result, isAmbiguous))
+    return Result;
+
   TentativeParsingAction PA(*this);
 
   // type-specifier-seq
@@ -390,6 +417,8 @@ bool Parser::isCXXTypeId(TentativeCXXTypeIdContext Context, bool &isAmbiguous) {
   PA.Revert();
 
   assert(TPR == TPResult::True() || TPR == TPResult::False());
+  if (Memoize)
+    cacheTentativeQuery(Key, TPR == TPResult::True(), isAmbiguous);
   return TPR == TPResult::True();
 }
 
@@ -855,6 +884,61 @@ Parser::isExpressionOrTypeSpecifierSimple(tok::TokenKind Kind) {
   return TPResult::Ambiguous();
 }
 
+bool Parser::getTentativeQueryKey(TentativeQueryKind Kind,
+                                  TentativeQueryKey &Key) {
+  if (Tok.getLocation().isInvalid())
+    return false;
+
+  // The result of a query depends on the identifiers declared earlier in the
+  // same tentative parse. Only the common cases of none and of the name of
+  // the declarator whose initializer is being disambiguated are memoized.
+  IdentifierInfo *Declared = 0;
+  if (TentativelyDeclaredIdentifiers.size() > 1)
+    return false;
+  if (!TentativelyDeclaredIdentifiers.empty())
+    Declared = TentativelyDeclaredIdentifiers.back();
+
+  unsigned State = Kind | (GreaterThanIsOperator << 3) | (ColonIsSacred << 4);
+  Key = TentativeQueryKey(std::make_pair(Tok.getLocation().getRawEncoding(),
+                                         State),
+                          Declared);
+  return true;
+}
+
+bool Parser::getCachedTentativeQuery(const TentativeQueryKey &Key,
+                                     bool &Result, bool &IsAmbiguous) {
+  ++NumTentativeQueries;
+
+  // The results depend on which names refer to types, so they are stale
+  // once a declaration has been added or removed.
+  unsigned Generation = Actions.IdResolver.getGeneration();
+  if (Generation != TentativeQueryCacheGeneration) {
+    TentativeQueryCache.clear();
+    TentativeQueryCacheGeneration = Generation;
+    return false;
+  }
+
+  llvm::DenseMap<TentativeQueryKey, unsigned char>::const_iterator Known
+    = TentativeQueryCache.find(Key);
+  if (Known == TentativeQueryCache.end())
+    return false;
+
+  ++NumTentativeQueryCacheHits;
+  Result = Known->second & 1;
+  IsAmbiguous = Known->second & 2;
+  return true;
+}
+
+void Parser::cacheTentativeQuery(const TentativeQueryKey &Key, bool Result,
+                                 bool IsAmbiguous) {
+  // Name lookup during the tentative parse may itself have declared
+  // something, e.g., an implicitly-declared builtin.
+  if (Actions.IdResolver.getGeneration() != TentativeQueryCacheGeneration)
+    return;
+
+  TentativeQueryCache[Key] = Result | (IsAmbiguous << 1);
+}
+
 bool Parser::isTentativelyDeclared(IdentifierInfo *II) {
   return std::find(TentativelyDeclaredIdentifiers.begin(),
                    TentativelyDeclaredIdentifiers.end(), II)
@@ -1385,6 +1469,15 @@ bool Parser::isCXXFunctionDeclarator(bool *IsAmbiguous) {
   // ambiguities mentioned in 6.8, the resolution is to consider any construct
   // that could possibly be a declaration a declaration.
 
+  TentativeQueryKey Key;
+  bool Memoize = getTentativeQueryKey(TQ_FunctionDeclarator, Key);
+  bool Result, Ambiguous;
+  if (Memoize && getCachedTentativeQuery(Key, Result, Ambiguous)) {
+    if (IsAmbiguous && Ambiguous)
+      *IsAmbiguous = true;
+    return Result;
+  }
+
   TentativeParsingAction PA(*this);
 
   ConsumeParen();
@@ -1417,6 +1510,9 @@ bool Parser::isCXXFunctionDeclarator(bool *IsAmbiguous) {
     *IsAmbiguous = true;
 
   // In case of an error, let the declaration parsing code handle it.
+  if (Memoize)
+    cacheTentativeQuery(Key, TPR != TPResult::False(),
+                        TPR == TPResult::Ambiguous());
   return TPR != TPResult::False();
 }
 
@@ -60,6 +60,8 @@ Parser::Parser(Preprocessor &pp, Sema &actions, bool skipFunctionBodies)
   NumCachedScopes = 0;
   ParenCount = BracketCount = BraceCount = 0;
   CurParsedObjCImpl = 0;
+  TentativeQueryCacheGeneration = Actions.IdResolver.getGeneration();
+  NumTentativeQueries = NumTentativeQueryCacheHits = 0;
 
   // Add #pragma handlers. These are removed and destroyed in the
   // destructor.
@@ -439,6 +441,13 @@ Parser::~Parser() {
   assert(TemplateIds.empty() && "Still alive TemplateIdAnnotations around?");
 }
 
+void Parser::PrintStats() const {
+  llvm::errs() << "\n*** Parser Stats:\n";
+  llvm::errs() << NumTentativeQueries
+               << " ambiguities resolved by tentative parsing, "
+               << NumTentativeQueryCacheHits << " from the cache.\n";
+}
+
 /// Initialize - Warm up the parser.
 ///
 void Parser::Initialize() {
@@ -544,7 +553,8 @@ bool Parser::ParseTopLevelDecl(DeclGroupPtrTy &Result) {
   Result = DeclGroupPtrTy();
   if (Tok.is(tok::eof)) {
     // Late template parsing can begin.
-    if (getLangOpts().DelayedTemplateParsing)
+    if (getLangOpts().DelayedTemplateParsing ||
+        getLangOpts().DelayedInlineMethodParsing)
       Actions.SetLateTemplateParser(LateTemplateParserCallback, this);
     if (!PP.isIncrementalProcessingEnabled())
       Actions.ActOnEndOfTranslationUnit();
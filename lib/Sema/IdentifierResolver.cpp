@@ -14,6 +14,9 @@
 
 #include "clang/Sema/IdentifierResolver.h"
 #include "clang/AST/Decl.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclObjC.h"
+#include "clang/AST/DeclTemplate.h"
 #include "clang/Basic/LangOptions.h"
 #include "clang/Lex/ExternalPreprocessorSource.h"
 #include "clang/Lex/Preprocessor.h"
@@ -96,7 +99,7 @@ IdentifierResolver::IdDeclInfo::ReplaceDecl(NamedDecl *Old, NamedDecl *New) {
 //===----------------------------------------------------------------------===//
 
 IdentifierResolver::IdentifierResolver(Preprocessor &PP)
-  : LangOpt(PP.getLangOpts()), PP(PP),
+  : LangOpt(PP.getLangOpts()), PP(PP), Generation(0),
     IdDeclInfos(new IdDeclInfoMap) {
 }
 
@@ -150,8 +153,48 @@ bool IdentifierResolver::isDeclInScope(Decl *D, DeclContext *Ctx, Scope *S,
            : Ctx->Equals(DCtx);
 }
 
+/// \brief Whether a name declared by \p D refers to a type, a template or a
+/// namespace, which is what the parser's disambiguation depends on.
+static bool isTypeLikeDecl(NamedDecl *D) {
+  D = D->getUnderlyingDecl();
+  return isa<TypeDecl>(D) || isa<TemplateDecl>(D) || isa<NamespaceDecl>(D) ||
+         isa<NamespaceAliasDecl>(D) || isa<ObjCInterfaceDecl>(D) ||
+         isa<ObjCCompatibleAliasDecl>(D);
+}
+
+void IdentifierResolver::noteDeclChange(NamedDecl *D) {
+  if (isTypeLikeDecl(D)) {
+    ++Generation;
+    return;
+  }
+
+  // Anything else only matters if it hides, or stops hiding, a declaration
+  // of a type, a template or a namespace with the same name. Don't use
+  // begin(), which may update the identifier from an external source.
+  void *Ptr = D->getDeclName().getFETokenInfo<void>();
+  if (!Ptr)
+    return;
+
+  if (isDeclPtr(Ptr)) {
+    if (isTypeLikeDecl(static_cast<NamedDecl*>(Ptr)))
+      ++Generation;
+    return;
+  }
+
+  IdDeclInfo *IDI = toIdDeclInfo(Ptr);
+  for (IdDeclInfo::DeclsTy::iterator I = IDI->decls_begin(),
+                                     E = IDI->decls_end();
+       I != E; ++I) {
+    if (isTypeLikeDecl(*I)) {
+      ++Generation;
+      return;
+    }
+  }
+}
+
 /// AddDecl - Link the decl to its shadowed decl chain.
 void IdentifierResolver::AddDecl(NamedDecl *D) {
+  noteDeclChange(D);
   DeclarationName Name = D->getDeclName();
   if (IdentifierInfo *II = Name.getAsIdentifierInfo())
     updatingIdentifier(*II);
@@ -177,6 +220,7 @@ void IdentifierResolver::AddDecl(NamedDecl *D) {
 }
 
 void IdentifierResolver::InsertDeclAfter(iterator Pos, NamedDecl *D) {
+  noteDeclChange(D);
   DeclarationName Name = D->getDeclName();
   if (IdentifierInfo *II = Name.getAsIdentifierInfo())
     updatingIdentifier(*II);
@@ -218,6 +262,7 @@ void IdentifierResolver::InsertDeclAfter(iterator Pos, NamedDecl *D) {
 /// The decl must already be part of the decl chain.
 void IdentifierResolver::RemoveDecl(NamedDecl *D) {
   assert(D && "null param passed");
+  noteDeclChange(D);
   DeclarationName Name = D->getDeclName();
   if (IdentifierInfo *II = Name.getAsIdentifierInfo())
     updatingIdentifier(*II);
@@ -238,6 +283,8 @@ void IdentifierResolver::RemoveDecl(NamedDecl *D) {
 bool IdentifierResolver::ReplaceDecl(NamedDecl *Old, NamedDecl *New) {
   assert(Old->getDeclName() == New->getDeclName() &&
          "Cannot replace a decl with another decl of a different name");
+  noteDeclChange(Old);
+  noteDeclChange(New);
 
   DeclarationName Name = Old->getDeclName();
   if (IdentifierInfo *II = Name.getAsIdentifierInfo())
@@ -25,6 +25,7 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/PartialDiagnostic.h"
 #include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/CXXFieldCollector.h"
@@ -37,6 +38,8 @@
 #include "clang/Sema/ScopeInfo.h"
 #include "clang/Sema/SemaConsumer.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
+#include "clang/Sema/TypoCorrectionIndex.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
@@ -87,10 +90,12 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
     GlobalNewDeleteDeclared(false),
     TUKind(TUKind),
     NumSFINAEErrors(0), InFunctionDeclarator(0),
-    AccessCheckingSFINAE(false), InNonInstantiationSFINAEContext(false),
+    AccessCheckingSFINAE(false),
+    NumTemplateDeductionCacheLookups(0), NumTemplateDeductionCacheHits(0),
+    InNonInstantiationSFINAEContext(false),
     NonInstantiationEntries(0), ArgumentPackSubstitutionIndex(-1),
     CurrentInstantiationScope(0), TyposCorrected(0),
-    AnalysisWarnings(*this)
+    AnalysisWarnings(*this), SkipFunctionTemplateInstantiations(false)
 {
   TUScope = 0;
 
@@ -251,9 +256,15 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumTemplateDeductionCacheHits << " of "
+               << NumTemplateDeductionCacheLookups
+               << " template argument deductions found in the cache, "
+               << TemplateDeductionCache.size() << " results cached.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
+  if (TypoIndex)
+    TypoIndex->PrintStats();
 }
 
 /// ImpCastExprToType - If Expr is not of type 'Type', insert an implicit cast.
@@ -402,6 +413,13 @@ void Sema::getUndefinedButUsed(
     if (FunctionDecl *FD = dyn_cast<FunctionDecl>(ND)) {
       if (FD->isDefined())
         continue;
+      // Skipped instantiations have a definition, we just never built it.
+      if (SkipFunctionTemplateInstantiations &&
+          FD->isImplicitlyInstantiable()) {
+        const FunctionDecl *Pattern = FD->getTemplateInstantiationPattern();
+        if (Pattern && Pattern->isDefined())
+          continue;
+      }
       if (FD->getLinkage() == ExternalLinkage &&
           !FD->getMostRecentDecl()->isInlined())
         continue;
@@ -483,8 +501,11 @@ static bool MethodsAndNestedClassesComplete(const CXXRecordDecl *RD,
   for (DeclContext::decl_iterator I = RD->decls_begin(),
                                   E = RD->decls_end();
        I != E && Complete; ++I) {
+    // The body of a late-parsed inline method that was never used has not been
+    // parsed, so it may still refer to anything in the class.
     if (const CXXMethodDecl *M = dyn_cast<CXXMethodDecl>(*I))
-      Complete = M->isDefined() || (M->isPure() && !isa<CXXDestructorDecl>(M));
+      Complete = (M->isDefined() && !M->isLateTemplateParsed()) ||
+                 (M->isPure() && !isa<CXXDestructorDecl>(M));
     else if (const FunctionTemplateDecl *F = dyn_cast<FunctionTemplateDecl>(*I))
       Complete = F->getTemplatedDecl()->isDefined();
     else if (const CXXRecordDecl *R = dyn_cast<CXXRecordDecl>(*I)) {
@@ -539,10 +560,50 @@ static bool IsRecordFullyDefined(const CXXRecordDecl *RD,
   return Complete;
 }
 
+/// \brief Returns true if the body of a late-parsed inline method that has not
+/// been parsed may refer to the given declaration.
+///
+/// Operators and conversion functions can be used without being named, so
+/// they are assumed to be referenced.
+static bool MayBeUsedByUnparsedInlineMethod(Sema &S, const DeclaratorDecl *D) {
+  if (S.LateParsedInlineMethods.empty())
+    return false;
+  IdentifierInfo *II = D->getIdentifier();
+  return !II || S.LateParsedInlineMethodNames.count(II);
+}
+
+/// \brief Parse the bodies of the late-parsed inline methods that have been
+/// used since the last call.
+///
+/// \returns true if any body was parsed.
+bool Sema::ParseUsedLateParsedInlineMethods() {
+  if (!LateTemplateParser)
+    return false;
+
+  SmallVector<FunctionDecl *, 16> Used;
+  unsigned NumUnused = 0;
+  for (unsigned I = 0, N = LateParsedInlineMethods.size(); I != N; ++I) {
+    FunctionDecl *FD = LateParsedInlineMethods[I];
+    if (!FD->isLateTemplateParsed())
+      continue;
+    if (FD->isUsed(false))
+      Used.push_back(FD);
+    else
+      LateParsedInlineMethods[NumUnused++] = FD;
+  }
+  LateParsedInlineMethods.resize(NumUnused);
+
+  for (unsigned I = 0, N = Used.size(); I != N; ++I)
+    LateTemplateParser(OpaqueParser, Used[I]);
+  return !Used.empty();
+}
+
 /// ActOnEndOfTranslationUnit - This is called at the very end of the
 /// translation unit when EOF is reached and all but the top-level scope is
 /// popped.
 void Sema::ActOnEndOfTranslationUnit() {
+  TimeTraceScope TraceScope("ActOnEndOfTranslationUnit");
+
   assert(DelayedDiagnostics.getCurrentPool() == NULL
          && "reached end of translation unit with a pool attached?");
 
@@ -587,6 +648,13 @@ void Sema::ActOnEndOfTranslationUnit() {
     // future, we either need to be able to filter the results of name lookup
     // or we need to perform template instantiations earlier.
     PerformPendingInstantiations();
+
+    // Parse the bodies of the late-parsed inline methods that turned out to
+    // be used. They may use more vtables, templates and inline methods.
+    while (ParseUsedLateParsedInlineMethods()) {
+      DefineUsedVTables();
+      PerformPendingInstantiations();
+    }
   }
 
   // Remove file scoped decls that turned out to be used.
@@ -700,10 +768,10 @@ void Sema::ActOnEndOfTranslationUnit() {
 
   }
 
+  // The diagnostics below are checked at the end of the translation unit, so
+  // ask whether they are enabled anywhere rather than at the last location.
   if (LangOpts.CPlusPlus11 &&
-      Diags.getDiagnosticLevel(diag::warn_delegating_ctor_cycle,
-                               SourceLocation())
-        != DiagnosticsEngine::Ignored)
+      !Diags.isIgnoredEverywhere(diag::warn_delegating_ctor_cycle))
     CheckDelegatingCtorCycles();
 
   // If there were errors, disable 'unused' warnings since they will mostly be
@@ -713,7 +781,8 @@ void Sema::ActOnEndOfTranslationUnit() {
     for (UnusedFileScopedDeclsType::iterator
            I = UnusedFileScopedDecls.begin(ExternalSource),
            E = UnusedFileScopedDecls.end(); I != E; ++I) {
-      if (ShouldRemoveFromUnused(this, *I))
+      if (ShouldRemoveFromUnused(this, *I) ||
+          MayBeUsedByUnparsedInlineMethod(*this, *I))
         continue;
 
       if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(*I)) {
@@ -762,9 +831,7 @@ void Sema::ActOnEndOfTranslationUnit() {
     checkUndefinedButUsed(*this);
   }
 
-  if (Diags.getDiagnosticLevel(diag::warn_unused_private_field,
-                               SourceLocation())
-        != DiagnosticsEngine::Ignored) {
+  if (!Diags.isIgnoredEverywhere(diag::warn_unused_private_field)) {
     RecordCompleteMap RecordsComplete;
     RecordCompleteMap MNCComplete;
     for (NamedDeclSetType::iterator I = UnusedPrivateFields.begin(),
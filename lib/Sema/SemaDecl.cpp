@@ -1352,6 +1352,10 @@ static void CheckPoppedLabel(LabelDecl *L, Sema &S) {
 }
 
 void Sema::ActOnPopScope(SourceLocation Loc, Scope *S) {
+  // The using-directives of this scope no longer affect name lookup.
+  if (S->using_directives_begin() != S->using_directives_end())
+    IdResolver.noteLookupChanged();
+
   if (S->decl_empty()) return;
   assert((S->getFlags() & (Scope::DeclScope | Scope::TemplateParamScope)) &&
          "Scope shouldn't contain decls!");
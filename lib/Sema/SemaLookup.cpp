@@ -32,6 +32,7 @@
 #include "clang/Sema/SemaInternal.h"
 #include "clang/Sema/TemplateDeduction.h"
 #include "clang/Sema/TypoCorrection.h"
+#include "clang/Sema/TypoCorrectionIndex.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
@@ -3801,26 +3802,20 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
   
   if (IsUnqualifiedLookup || SearchNamespaces) {
     // For unqualified lookup, look through all of the names that we have
-    // seen in this translation unit.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
-    for (IdentifierTable::iterator I = Context.Idents.begin(),
-                                IEnd = Context.Idents.end();
-         I != IEnd; ++I)
-      Consumer.FoundName(I->getKey());
-
-    // Walk through identifiers in external identifier sources.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
-    if (IdentifierInfoLookup *External
-                            = Context.Idents.getExternalIdentifierLookup()) {
-      OwningPtr<IdentifierIterator> Iter(External->getIdentifiers());
-      do {
-        StringRef Name = Iter->Next();
-        if (Name.empty())
-          break;
-
-        Consumer.FoundName(Name);
-      } while (true);
-    }
+    // seen in this translation unit, the available builtins and the
+    // identifiers in external identifier sources. The index skips the names
+    // that are too far from the typo to ever be accepted as corrections (see
+    // TypoCorrectionConsumer::FoundName).
+    if (!TypoIndex)
+      TypoIndex.reset(new TypoCorrectionIndex(Context.Idents));
+    TypoIndex->update(Context.BuiltinInfo);
+
+    StringRef TypoStr = Typo->getName();
+    SmallVector<StringRef, 64> Candidates;
+    TypoIndex->lookup(TypoStr, TypoStr.size() / 3,
+                      getLangOpts().TypoCorrectionBudget, Candidates);
+    for (unsigned I = 0, N = Candidates.size(); I != N; ++I)
+      Consumer.FoundName(Candidates[I]);
   }
 
   AddKeywordsToConsumer(*this, Consumer, S, CCC, SS && SS->isNotEmpty());
@@ -43,8 +43,11 @@ CreateFunctionRefExpr(Sema &S, FunctionDecl *Fn, NamedDecl *FoundDecl,
                       bool HadMultipleCandidates,
                       SourceLocation Loc = SourceLocation(), 
                       const DeclarationNameLoc &LocInfo = DeclarationNameLoc()){
-  DeclRefExpr *DRE = new (S.Context) DeclRefExpr(Fn, false, Fn->getType(),
-                                                 VK_LValue, Loc, LocInfo);
+  DeclRefExpr *DRE
+    = DeclRefExpr::Create(S.Context, NestedNameSpecifierLoc(),
+                          SourceLocation(), Fn, false,
+                          DeclarationNameInfo(Fn->getDeclName(), Loc, LocInfo),
+                          Fn->getType(), VK_LValue);
   if (HadMultipleCandidates)
     DRE->setHadMultipleCandidates(true);
 
@@ -789,6 +792,7 @@ void OverloadCandidateSet::clear() {
   destroyCandidates();
   NumInlineSequences = 0;
   Candidates.clear();
+  RejectedCandidates.clear();
   Functions.clear();
 }
 
@@ -5307,6 +5311,40 @@ Sema::ConvertToIntegralOrEnumerationType(SourceLocation Loc, Expr *From,
   return DefaultLvalueConversion(From);
 }
 
+/// \brief Determine whether a call with \p NumArgs arguments has the wrong
+/// number of arguments for \p Function, which is checked before any work is
+/// done to build a candidate for it.
+///
+/// For function templates these are the checks that template argument
+/// deduction from a call performs before deducing anything.
+static bool isArityMismatch(FunctionDecl *Function, unsigned NumArgs,
+                            bool PartialOverloading,
+                            OverloadFailureKind &FailureKind) {
+  const FunctionProtoType *Proto
+    = Function->getType()->getAs<FunctionProtoType>();
+
+  // (C++ 13.3.2p2): A candidate function having fewer than m
+  // parameters is viable only if it has an ellipsis in its parameter
+  // list (8.3.5).
+  if ((NumArgs + (PartialOverloading && NumArgs)) > Proto->getNumArgs() &&
+      !Proto->isVariadic() && !Proto->isTemplateVariadic()) {
+    FailureKind = ovl_fail_too_many_arguments;
+    return true;
+  }
+
+  // (C++ 13.3.2p2): A candidate function having more than m parameters
+  // is viable only if the (m+1)st parameter has a default argument
+  // (8.3.6). For the purposes of overload resolution, the
+  // parameter list is truncated on the right, so that there are
+  // exactly m parameters.
+  if (NumArgs < Function->getMinRequiredArguments() && !PartialOverloading) {
+    FailureKind = ovl_fail_too_few_arguments;
+    return true;
+  }
+
+  return false;
+}
+
 /// AddOverloadCandidate - Adds the given function to the set of
 /// candidate functions, using the given function call arguments.  If
 /// @p SuppressUserConversions, then don't allow user-defined
@@ -5350,6 +5388,14 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
   if (!CandidateSet.isNewCandidate(Function))
     return;
 
+  OverloadFailureKind ArityFailure;
+  if (isArityMismatch(Function, Args.size(), PartialOverloading,
+                      ArityFailure)) {
+    CandidateSet.addRejectedCandidate(Function, FoundDecl, Args.size(),
+                                      ArityFailure, /*IsTemplate=*/false);
+    return;
+  }
+
   // Overload resolution is always an unevaluated context.
   EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
 
@@ -5376,29 +5422,6 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
 
   unsigned NumArgsInProto = Proto->getNumArgs();
 
-  // (C++ 13.3.2p2): A candidate function having fewer than m
-  // parameters is viable only if it has an ellipsis in its parameter
-  // list (8.3.5).
-  if ((Args.size() + (PartialOverloading && Args.size())) > NumArgsInProto &&
-      !Proto->isVariadic()) {
-    Candidate.Viable = false;
-    Candidate.FailureKind = ovl_fail_too_many_arguments;
-    return;
-  }
-
-  // (C++ 13.3.2p2): A candidate function having more than m parameters
-  // is viable only if the (m+1)st parameter has a default argument
-  // (8.3.6). For the purposes of overload resolution, the
-  // parameter list is truncated on the right, so that there are
-  // exactly m parameters.
-  unsigned MinRequiredArgs = Function->getMinRequiredArguments();
-  if (Args.size() < MinRequiredArgs && !PartialOverloading) {
-    // Not enough arguments.
-    Candidate.Viable = false;
-    Candidate.FailureKind = ovl_fail_too_few_arguments;
-    return;
-  }
-
   // (CUDA B.1): Check for invalid calls between targets.
   if (getLangOpts().CUDA)
     if (const FunctionDecl *Caller = dyn_cast<FunctionDecl>(CurContext))
@@ -5528,6 +5551,14 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
   if (!CandidateSet.isNewCandidate(Method))
     return;
 
+  OverloadFailureKind ArityFailure;
+  if (isArityMismatch(Method, Args.size(), /*PartialOverloading=*/false,
+                      ArityFailure)) {
+    CandidateSet.addRejectedCandidate(Method, FoundDecl, Args.size(),
+                                      ArityFailure, /*IsTemplate=*/false);
+    return;
+  }
+
   // Overload resolution is always an unevaluated context.
   EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
 
@@ -5540,29 +5571,6 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
   Candidate.ExplicitCallArguments = Args.size();
 
   unsigned NumArgsInProto = Proto->getNumArgs();
-
-  // (C++ 13.3.2p2): A candidate function having fewer than m
-  // parameters is viable only if it has an ellipsis in its parameter
-  // list (8.3.5).
-  if (Args.size() > NumArgsInProto && !Proto->isVariadic()) {
-    Candidate.Viable = false;
-    Candidate.FailureKind = ovl_fail_too_many_arguments;
-    return;
-  }
-
-  // (C++ 13.3.2p2): A candidate function having more than m parameters
-  // is viable only if the (m+1)st parameter has a default argument
-  // (8.3.6). For the purposes of overload resolution, the
-  // parameter list is truncated on the right, so that there are
-  // exactly m parameters.
-  unsigned MinRequiredArgs = Method->getMinRequiredArguments();
-  if (Args.size() < MinRequiredArgs) {
-    // Not enough arguments.
-    Candidate.Viable = false;
-    Candidate.FailureKind = ovl_fail_too_few_arguments;
-    return;
-  }
-
   Candidate.Viable = true;
 
   if (Method->isStatic() || ObjectType.isNull())
@@ -5626,6 +5634,16 @@ Sema::AddMethodTemplateCandidate(FunctionTemplateDecl *MethodTmpl,
   if (!CandidateSet.isNewCandidate(MethodTmpl))
     return;
 
+  OverloadFailureKind ArityFailure;
+  if (!MethodTmpl->isInvalidDecl() &&
+      isArityMismatch(MethodTmpl->getTemplatedDecl(), Args.size(),
+                      /*PartialOverloading=*/false, ArityFailure)) {
+    CandidateSet.addRejectedCandidate(MethodTmpl->getTemplatedDecl(),
+                                      FoundDecl, Args.size(), ArityFailure,
+                                      /*IsTemplate=*/true);
+    return;
+  }
+
   // C++ [over.match.funcs]p7:
   //   In each case where a candidate is a function template, candidate
   //   function template specializations are generated using template argument
@@ -5676,6 +5694,16 @@ Sema::AddTemplateOverloadCandidate(FunctionTemplateDecl *FunctionTemplate,
   if (!CandidateSet.isNewCandidate(FunctionTemplate))
     return;
 
+  OverloadFailureKind ArityFailure;
+  if (!FunctionTemplate->isInvalidDecl() &&
+      isArityMismatch(FunctionTemplate->getTemplatedDecl(), Args.size(),
+                      /*PartialOverloading=*/false, ArityFailure)) {
+    CandidateSet.addRejectedCandidate(FunctionTemplate->getTemplatedDecl(),
+                                      FoundDecl, Args.size(), ArityFailure,
+                                      /*IsTemplate=*/true);
+    return;
+  }
+
   // C++ [over.match.funcs]p7:
   //   In each case where a candidate is a function template, candidate
   //   function template specializations are generated using template argument
@@ -8934,6 +8962,38 @@ void OverloadCandidateSet::NoteCandidates(Sema &S,
     }
   }
 
+  // Build the candidates that were rejected on arity now that they are
+  // needed. They are kept out of the set itself so that iterators into it,
+  // such as the best viable function, stay valid.
+  SmallVector<OverloadCandidate, 8> Rejected;
+  if (OCD == OCD_AllCandidates) {
+    Rejected.reserve(RejectedCandidates.size());
+    for (unsigned I = 0, N = RejectedCandidates.size(); I != N; ++I) {
+      const RejectedCandidate &R = RejectedCandidates[I];
+      Rejected.push_back(OverloadCandidate());
+      OverloadCandidate &Cand = Rejected.back();
+      Cand.Function = R.Function;
+      Cand.FoundDecl = R.FoundDecl;
+      Cand.Conversions = 0;
+      Cand.NumConversions = 0;
+      Cand.Viable = false;
+      Cand.IsSurrogate = false;
+      Cand.IgnoreObjectArgument = false;
+      Cand.ExplicitCallArguments = R.ExplicitCallArguments;
+      if (R.IsTemplate) {
+        Cand.FailureKind = ovl_fail_bad_deduction;
+        Cand.DeductionFailure.Result
+          = R.FailureKind == ovl_fail_too_many_arguments
+              ? Sema::TDK_TooManyArguments : Sema::TDK_TooFewArguments;
+        Cand.DeductionFailure.HasDiagnostic = false;
+        Cand.DeductionFailure.Data = 0;
+      } else {
+        Cand.FailureKind = R.FailureKind;
+      }
+      Cands.push_back(&Cand);
+    }
+  }
+
   std::sort(Cands.begin(), Cands.end(),
             CompareOverloadCandidatesForDisplay(S));
 
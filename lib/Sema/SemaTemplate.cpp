@@ -7374,6 +7374,16 @@ void Sema::MarkAsLateParsedTemplate(FunctionDecl *FD, bool Flag) {
   FD->setLateTemplateParsed(Flag);
 } 
 
+void Sema::MarkAsLateParsedInlineMethod(FunctionDecl *FD,
+                                        const CachedTokens &Toks) {
+  MarkAsLateParsedTemplate(FD);
+  LateParsedInlineMethods.push_back(FD);
+
+  for (unsigned I = 0, N = Toks.size(); I != N; ++I)
+    if (Toks[I].is(tok::identifier))
+      LateParsedInlineMethodNames.insert(Toks[I].getIdentifierInfo());
+}
+
 bool Sema::IsInsideALocalClassWithinATemplateFunction() {
   DeclContext *DC = CurContext;
 
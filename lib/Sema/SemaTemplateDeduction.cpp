@@ -3058,11 +3058,11 @@ DeduceTemplateArgumentByListElement(Sema &S,
 ///
 /// \returns the result of template argument deduction.
 Sema::TemplateDeductionResult
-Sema::DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
-                              TemplateArgumentListInfo *ExplicitTemplateArgs,
-                              llvm::ArrayRef<Expr *> Args,
-                              FunctionDecl *&Specialization,
-                              TemplateDeductionInfo &Info) {
+Sema::DeduceTemplateArgumentsFromCall(FunctionTemplateDecl *FunctionTemplate,
+                               TemplateArgumentListInfo *ExplicitTemplateArgs,
+                                      llvm::ArrayRef<Expr *> Args,
+                                      FunctionDecl *&Specialization,
+                                      TemplateDeductionInfo &Info) {
   if (FunctionTemplate->isInvalidDecl())
     return TDK_Invalid;
 
@@ -3293,6 +3293,145 @@ Sema::DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
                                          Specialization, Info, &OriginalCallArgs);
 }
 
+/// \brief Determine whether template argument deduction against an argument
+/// of type \p T gives the same result wherever it is performed.
+///
+/// Deduction can look through pointers and references to a class and into
+/// the class's bases, and the bases of a class that is incomplete or still
+/// being defined are not yet known. Deduction from an array of unknown bound
+/// looks at the declaration the argument refers to, which may since have
+/// been given a bound.
+static bool isStableForDeduction(QualType T) {
+  if (const ReferenceType *Ref = T->getAs<ReferenceType>())
+    T = Ref->getPointeeType();
+  if (T->isIncompleteArrayType())
+    return false;
+  while (const ArrayType *Array = T->getAsArrayTypeUnsafe())
+    T = Array->getElementType();
+  if (const PointerType *Ptr = T->getAs<PointerType>())
+    T = Ptr->getPointeeType();
+  else if (const MemberPointerType *MemPtr = T->getAs<MemberPointerType>())
+    return isStableForDeduction(QualType(MemPtr->getClass(), 0)) &&
+           isStableForDeduction(MemPtr->getPointeeType());
+
+  if (const RecordType *Record = T->getAs<RecordType>()) {
+    const RecordDecl *Def = Record->getDecl()->getDefinition();
+    return Def && !Def->isBeingDefined();
+  }
+  return true;
+}
+
+/// \brief Compute the key under which the result of deducing template
+/// arguments of \p FunctionTemplate from the call arguments \p Args is
+/// cached.
+///
+/// \returns false if the result depends on more than the types and value
+/// categories of the arguments, and so cannot be cached.
+static bool ProfileTemplateDeduction(ASTContext &Context,
+                                     FunctionTemplateDecl *FunctionTemplate,
+                                     llvm::ArrayRef<Expr *> Args,
+                                     llvm::FoldingSetNodeID &ID) {
+  ID.AddPointer(FunctionTemplate);
+  ID.AddInteger(Args.size());
+  for (unsigned I = 0, N = Args.size(); I != N; ++I) {
+    // Initializer lists and overloaded function names are deduced from the
+    // expressions themselves.
+    Expr *Arg = Args[I];
+    if (isa<InitListExpr>(Arg))
+      return false;
+
+    QualType ArgType = Arg->getType();
+    if (ArgType->isPlaceholderType() || ArgType->isDependentType() ||
+        !isStableForDeduction(ArgType))
+      return false;
+
+    ID.AddPointer(Context.getCanonicalType(ArgType).getAsOpaquePtr());
+    ID.AddBoolean(Arg->isLValue());
+  }
+  return true;
+}
+
+/// \brief Determine whether a deduction result can be reused for another
+/// call with the same argument types.
+///
+/// Substitution failures are not cached, because they hand the deduced
+/// arguments and the SFINAE diagnostic of this attempt to the caller through
+/// the \c TemplateDeductionInfo.
+static bool isCacheableDeductionResult(Sema::TemplateDeductionResult Result) {
+  switch (Result) {
+  case Sema::TDK_Success:
+  case Sema::TDK_Incomplete:
+  case Sema::TDK_Inconsistent:
+  case Sema::TDK_Underqualified:
+  case Sema::TDK_NonDeducedMismatch:
+  case Sema::TDK_TooManyArguments:
+  case Sema::TDK_TooFewArguments:
+    return true;
+
+  case Sema::TDK_Invalid:
+  case Sema::TDK_InstantiationDepth:
+  case Sema::TDK_SubstitutionFailure:
+  case Sema::TDK_InvalidExplicitArguments:
+  case Sema::TDK_FailedOverloadResolution:
+  case Sema::TDK_MiscellaneousDeductionFailure:
+    return false;
+  }
+  llvm_unreachable("Invalid TemplateDeductionResult!");
+}
+
+/// \brief Perform template argument deduction from a function call,
+/// reusing the result of an earlier deduction for the same function template
+/// and argument types where that is sound.
+///
+/// See \c DeduceTemplateArgumentsFromCall for the meaning of the parameters.
+Sema::TemplateDeductionResult
+Sema::DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
+                              TemplateArgumentListInfo *ExplicitTemplateArgs,
+                              llvm::ArrayRef<Expr *> Args,
+                              FunctionDecl *&Specialization,
+                              TemplateDeductionInfo &Info) {
+  llvm::FoldingSetNodeID ID;
+  void *InsertPos = 0;
+  if (ExplicitTemplateArgs ||
+      !ProfileTemplateDeduction(Context, FunctionTemplate, Args, ID))
+    return DeduceTemplateArgumentsFromCall(FunctionTemplate,
+                                           ExplicitTemplateArgs, Args,
+                                           Specialization, Info);
+
+  ++NumTemplateDeductionCacheLookups;
+  if (CachedTemplateDeduction *Cached
+        = TemplateDeductionCache.FindNodeOrInsertPos(ID, InsertPos)) {
+    ++NumTemplateDeductionCacheHits;
+    Specialization = Cached->Specialization;
+    Info.Param = TemplateParameter::getFromOpaqueValue(Cached->Param);
+    Info.FirstArg = Cached->FirstArg;
+    Info.SecondArg = Cached->SecondArg;
+    return Cached->Result;
+  }
+
+  TemplateDeductionResult Result
+    = DeduceTemplateArgumentsFromCall(FunctionTemplate, 0, Args,
+                                      Specialization, Info);
+  if (!isCacheableDeductionResult(Result))
+    return Result;
+
+  // Deduction may have instantiated templates and thereby changed the cache.
+  if (TemplateDeductionCache.FindNodeOrInsertPos(ID, InsertPos))
+    return Result;
+
+  CachedTemplateDeduction *Cached
+    = new (BumpAlloc.Allocate<CachedTemplateDeduction>())
+        CachedTemplateDeduction(ID);
+  Cached->Result = Result;
+  if (Result == TDK_Success)
+    Cached->Specialization = Specialization;
+  Cached->Param = Info.Param.getOpaqueValue();
+  Cached->FirstArg = Info.FirstArg;
+  Cached->SecondArg = Info.SecondArg;
+  TemplateDeductionCache.InsertNode(Cached, InsertPos);
+  return Result;
+}
+
 /// \brief Deduce template arguments when taking the address of a function
 /// template (C++ [temp.deduct.funcaddr]) or matching a specialization to
 /// a template.
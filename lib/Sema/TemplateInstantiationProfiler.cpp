@@ -0,0 +1,216 @@
+//===--- TemplateInstantiationProfiler.cpp - Instantiation cost report ----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the cost accounting for template instantiations
+// requested by -print-template-profile and -template-profile-trace.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Sema/TemplateInstantiationProfiler.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+using namespace clang;
+using namespace sema;
+
+typedef Sema::ActiveTemplateInstantiation ActiveTemplateInstantiation;
+
+/// \brief Describe what kind of instantiation \p Inst is.
+static const char *getKindName(const ActiveTemplateInstantiation &Inst) {
+  switch (Inst.Kind) {
+  case ActiveTemplateInstantiation::TemplateInstantiation:
+    if (isa<CXXRecordDecl>(Inst.Entity))
+      return "class";
+    if (isa<FunctionDecl>(Inst.Entity))
+      return "function";
+    if (isa<VarDecl>(Inst.Entity))
+      return "variable";
+    return "member";
+  case ActiveTemplateInstantiation::ExceptionSpecInstantiation:
+    return "exception spec";
+  case ActiveTemplateInstantiation::DefaultTemplateArgumentInstantiation:
+    return "default template arg";
+  case ActiveTemplateInstantiation::DefaultFunctionArgumentInstantiation:
+    return "default function arg";
+  case ActiveTemplateInstantiation::ExplicitTemplateArgumentSubstitution:
+    return "explicit arg substitution";
+  case ActiveTemplateInstantiation::DeducedTemplateArgumentSubstitution:
+    return "deduction";
+  case ActiveTemplateInstantiation::PriorTemplateArgumentSubstitution:
+    return "prior arg substitution";
+  case ActiveTemplateInstantiation::DefaultTemplateArgumentChecking:
+    return "default arg checking";
+  }
+  llvm_unreachable("Invalid InstantiationKind!");
+}
+
+/// \brief Find the declaration that the given instantiated entity was
+/// instantiated from: a class or function template, a class template partial
+/// specialization, or a member of a class template.
+static const NamedDecl *getPattern(const Decl *D) {
+  if (const ClassTemplateSpecializationDecl *Spec
+        = dyn_cast<ClassTemplateSpecializationDecl>(D)) {
+    llvm::PointerUnion<ClassTemplateDecl *,
+                       ClassTemplatePartialSpecializationDecl *> Pattern
+      = Spec->getSpecializedTemplateOrPartial();
+    if (ClassTemplatePartialSpecializationDecl *Partial
+          = Pattern.dyn_cast<ClassTemplatePartialSpecializationDecl *>())
+      return Partial;
+    return Pattern.get<ClassTemplateDecl *>();
+  }
+  if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D)) {
+    if (const CXXRecordDecl *Member = RD->getInstantiatedFromMemberClass())
+      return Member;
+  } else if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D)) {
+    if (const FunctionTemplateDecl *Template = FD->getPrimaryTemplate())
+      return Template;
+    if (const FunctionDecl *Member = FD->getInstantiatedFromMemberFunction())
+      return Member;
+  } else if (const ParmVarDecl *Param = dyn_cast<ParmVarDecl>(D)) {
+    // Default function arguments are charged to their function.
+    if (const FunctionDecl *FD
+          = dyn_cast<FunctionDecl>(Param->getDeclContext()))
+      return getPattern(FD);
+  } else if (const VarDecl *VD = dyn_cast<VarDecl>(D)) {
+    if (const VarDecl *Member = VD->getInstantiatedFromStaticDataMember())
+      return Member;
+  }
+  return dyn_cast<NamedDecl>(D);
+}
+
+TemplateInstantiationProfiler::TemplateInstantiationProfiler(
+                                                          ASTContext &Context)
+  : Context(Context) { }
+
+void TemplateInstantiationProfiler::startInstantiation(
+                                   const ActiveTemplateInstantiation &Inst) {
+  if (!Stack.empty())
+    ++Stack.back().Nested;
+
+  Frame F;
+  F.Start = TimeTrace::getCurrentTime();
+  F.StartBytes = Context.getASTAllocatedMemory();
+  F.ChildTime = 0;
+  F.ChildBytes = 0;
+  F.Nested = 0;
+  Stack.push_back(F);
+}
+
+void TemplateInstantiationProfiler::finishInstantiation(
+                                   const ActiveTemplateInstantiation &Inst) {
+  assert(!Stack.empty() && "Unbalanced template instantiation stack");
+  Frame F = Stack.pop_back_val();
+  double Duration = TimeTrace::getCurrentTime() - F.Start;
+  size_t Bytes = Context.getASTAllocatedMemory() - F.StartBytes;
+
+  double SelfTime = std::max(Duration - F.ChildTime, 0.0);
+  uint64_t SelfBytes = Bytes - std::min(Bytes, F.ChildBytes);
+  if (!Stack.empty()) {
+    Stack.back().ChildTime += Duration;
+    Stack.back().ChildBytes += Bytes;
+  }
+
+  // Name the specialization and the template it came from.
+  const char *Kind = getKindName(Inst);
+  std::string Name;
+  const Decl *Entity = Inst.Entity;
+  if (const ParmVarDecl *Param = dyn_cast_or_null<ParmVarDecl>(Entity))
+    Entity = cast<Decl>(Param->getDeclContext());
+  if (const NamedDecl *ND = dyn_cast_or_null<NamedDecl>(Entity))
+    ND->getNameForDiagnostic(Name, Context.getPrintingPolicy(),
+                             /*Qualified=*/true);
+
+  std::string TemplateName;
+  std::string FileName;
+  if (const NamedDecl *Pattern = Entity ? getPattern(Entity) : 0) {
+    TemplateName = Pattern->getQualifiedNameAsString();
+    SourceManager &SM = Context.getSourceManager();
+    PresumedLoc PLoc
+      = SM.getPresumedLoc(SM.getExpansionLoc(Pattern->getLocation()));
+    if (PLoc.isValid())
+      FileName = PLoc.getFilename();
+  }
+
+  Cost *Costs[] = {
+    &Total,
+    &BySpecialization[std::string(Kind) + " " + Name],
+    &ByTemplate[TemplateName],
+    &ByFile[FileName]
+  };
+  for (unsigned I = 0; I != llvm::array_lengthof(Costs); ++I) {
+    Cost &C = *Costs[I];
+    ++C.Count;
+    C.Nested += F.Nested;
+    C.Time += Duration;
+    C.SelfTime += SelfTime;
+    C.SelfBytes += SelfBytes;
+  }
+
+  TimeTrace::Event Event;
+  Event.Name.swap(Name);
+  Event.Category = Kind;
+  Event.Start = F.Start;
+  Event.Duration = Duration;
+  Event.Args.push_back(std::make_pair("template", TemplateName));
+  Event.Counts.push_back(std::make_pair("bytes", (uint64_t)Bytes));
+  Trace.addEvent(Event);
+  if (TimeTrace *Active = TimeTrace::getActive())
+    Active->addEvent(Event);
+}
+
+typedef std::pair<StringRef, const TemplateInstantiationProfiler::Cost *>
+  CostEntry;
+
+static bool compareBySelfTime(const CostEntry &LHS, const CostEntry &RHS) {
+  if (LHS.second->SelfTime != RHS.second->SelfTime)
+    return LHS.second->SelfTime > RHS.second->SelfTime;
+  return LHS.first < RHS.first;
+}
+
+void TemplateInstantiationProfiler::PrintTable(raw_ostream &OS,
+                                               StringRef Title,
+                                               const CostMap &Costs,
+                                               unsigned Limit) {
+  std::vector<CostEntry> Sorted;
+  Sorted.reserve(Costs.size());
+  for (CostMap::const_iterator I = Costs.begin(), E = Costs.end(); I != E; ++I)
+    Sorted.push_back(CostEntry(I->first(), &I->second));
+  std::sort(Sorted.begin(), Sorted.end(), compareBySelfTime);
+
+  OS << "  " << Title << " (" << Costs.size() << " total):\n";
+  OS << "     Self(s)   Total(s)   Self bytes    Count   Nested  Name\n";
+  for (unsigned I = 0, N = std::min<size_t>(Limit, Sorted.size()); I != N;
+       ++I) {
+    const Cost &C = *Sorted[I].second;
+    OS << llvm::format("  %10.4f %10.4f %12llu %8u %8u  ", C.SelfTime, C.Time,
+                       (unsigned long long)C.SelfBytes, C.Count, C.Nested)
+       << (Sorted[I].first.empty() ? StringRef("<unknown>") : Sorted[I].first)
+       << "\n";
+  }
+}
+
+void TemplateInstantiationProfiler::PrintReport(raw_ostream &OS,
+                                                unsigned Limit) const {
+  OS << "\n*** Template Instantiation Profile:\n";
+  OS << "  " << Total.Count << " instantiations took "
+     << llvm::format("%.4f", Total.SelfTime) << " seconds and allocated "
+     << Total.SelfBytes << " bytes of AST.\n";
+  PrintTable(OS, "Specializations", BySpecialization, Limit);
+  PrintTable(OS, "Templates", ByTemplate, Limit);
+  PrintTable(OS, "Files", ByFile, Limit);
+}
+
+void TemplateInstantiationProfiler::WriteTrace(raw_ostream &OS) const {
+  Trace.write(OS);
+}
@@ -1543,10 +1543,12 @@ public:
       Base = BaseResult.take();
       ExprValueKind VK = isArrow ? VK_LValue : Base->getValueKind();
       MemberExpr *ME =
-        new (getSema().Context) MemberExpr(Base, isArrow,
-                                           Member, MemberNameInfo,
-                                           cast<FieldDecl>(Member)->getType(),
-                                           VK, OK_Ordinary);
+        MemberExpr::Create(getSema().Context, Base, isArrow,
+                           NestedNameSpecifierLoc(), SourceLocation(), Member,
+                           DeclAccessPair::make(Member, Member->getAccess()),
+                           MemberNameInfo, /*TemplateArgs=*/0,
+                           cast<FieldDecl>(Member)->getType(),
+                           VK, OK_Ordinary);
       return getSema().Owned(ME);
     }
 
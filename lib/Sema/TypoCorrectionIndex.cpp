@@ -0,0 +1,162 @@
+//===--- TypoCorrectionIndex.cpp - Index of typo correction names ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the index of names used by Sema::CorrectTypo.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Sema/TypoCorrectionIndex.h"
+#include "clang/Basic/Builtins.h"
+#include "clang/Basic/IdentifierTable.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+
+/// \brief Map a character of an identifier to a bit of its signature.
+static unsigned getCharacterBit(unsigned char C) {
+  if (C >= 'a' && C <= 'z')
+    return C - 'a';
+  if (C >= 'A' && C <= 'Z')
+    return 26 + (C - 'A');
+  if (C >= '0' && C <= '9')
+    return 52 + (C - '0');
+  if (C == '_')
+    return 62;
+  return 63;
+}
+
+/// \brief Compute the set of characters in \p Name.
+static uint64_t getSignature(StringRef Name) {
+  uint64_t Signature = 0;
+  for (unsigned I = 0, N = Name.size(); I != N; ++I)
+    Signature |= uint64_t(1) << getCharacterBit(Name[I]);
+  return Signature;
+}
+
+TypoCorrectionIndex::TypoCorrectionIndex(IdentifierTable &Idents)
+  : Idents(Idents), Initialized(false), IndexedExternalNames(false),
+    ExternalGeneration(0), NumLookups(0), NumCompared(0), NumPruned(0),
+    NumOverBudget(0) { }
+
+TypoCorrectionIndex::~TypoCorrectionIndex() {
+  if (Initialized)
+    Idents.setNewIdentifierNames(0);
+}
+
+void TypoCorrectionIndex::insert(StringRef Name) {
+  if (Name.empty())
+    return;
+
+  llvm::StringMapEntry<char> &Known = Names.GetOrCreateValue(Name, 0);
+  if (Known.getValue())
+    return;
+  Known.setValue(1);
+
+  if (Name.size() >= ByLength.size())
+    ByLength.resize(Name.size() + 1);
+  Entry E;
+  E.Name = Known.getKey();
+  E.Signature = getSignature(Name);
+  ByLength[Name.size()].push_back(E);
+}
+
+void TypoCorrectionIndex::update(const Builtin::Context &Builtins) {
+  if (!Initialized) {
+    Initialized = true;
+    for (IdentifierTable::iterator I = Idents.begin(), E = Idents.end();
+         I != E; ++I)
+      insert(I->getKey());
+    Idents.setNewIdentifierNames(&NewIdentifierNames);
+
+    // Builtins only enter the identifier table once they are referenced, so
+    // index the names of all the available ones too.
+    SmallVector<const char *, 128> BuiltinNames;
+    Builtins.GetAvailableBuiltinNames(BuiltinNames);
+    for (unsigned I = 0, N = BuiltinNames.size(); I != N; ++I)
+      insert(BuiltinNames[I]);
+  } else {
+    for (unsigned I = 0, N = NewIdentifierNames.size(); I != N; ++I)
+      insert(NewIdentifierNames[I]);
+  }
+  NewIdentifierNames.clear();
+
+  // Walk the identifiers of the external source again whenever it has loaded
+  // more, e.g. because a module was imported since the last correction.
+  IdentifierInfoLookup *External = Idents.getExternalIdentifierLookup();
+  if (!External ||
+      (IndexedExternalNames && External->getGeneration() == ExternalGeneration))
+    return;
+  IndexedExternalNames = true;
+  ExternalGeneration = External->getGeneration();
+
+  OwningPtr<IdentifierIterator> Iter(External->getIdentifiers());
+  do {
+    StringRef Name = Iter->Next();
+    if (Name.empty())
+      break;
+
+    insert(Name);
+  } while (true);
+}
+
+bool TypoCorrectionIndex::lookup(StringRef Typo, unsigned MaxDistance,
+                                 unsigned Budget,
+                                 SmallVectorImpl<StringRef> &Candidates) {
+  ++NumLookups;
+  uint64_t TypoSignature = getSignature(Typo);
+  unsigned Length = Typo.size();
+  unsigned Found = 0;
+  bool OverBudget = false;
+
+  // Visit the buckets in order of their distance from the length of the typo,
+  // so that a budget cuts off the least likely names.
+  for (unsigned Delta = 0; Delta <= MaxDistance && !OverBudget; ++Delta) {
+    for (unsigned Longer = 0; Longer != 2 && !OverBudget; ++Longer) {
+      if ((Longer && !Delta) || (!Longer && Delta > Length))
+        continue;
+
+      unsigned BucketLength = Longer ? Length + Delta : Length - Delta;
+      if (BucketLength >= ByLength.size())
+        continue;
+
+      const std::vector<Entry> &Bucket = ByLength[BucketLength];
+      for (unsigned I = 0, N = Bucket.size(); I != N; ++I) {
+        unsigned Differences
+          = llvm::CountPopulation_64(Bucket[I].Signature ^ TypoSignature);
+        if ((Differences + 1) / 2 > MaxDistance)
+          continue;
+
+        if (Budget && Found == Budget) {
+          OverBudget = true;
+          break;
+        }
+        Candidates.push_back(Bucket[I].Name);
+        ++Found;
+      }
+    }
+  }
+
+  NumCompared += Found;
+  NumPruned += Names.size() - Found;
+  if (OverBudget)
+    ++NumOverBudget;
+  return OverBudget;
+}
+
+void TypoCorrectionIndex::PrintStats() const {
+  llvm::errs() << "\n*** Typo Correction Index Stats:\n";
+  llvm::errs() << Names.size() << " names indexed.\n";
+  llvm::errs() << NumLookups << " lookups, " << NumCompared
+               << " names compared, " << NumPruned << " names skipped.\n";
+  llvm::errs() << NumOverBudget
+               << " lookups exceeded the typo correction budget.\n";
+}
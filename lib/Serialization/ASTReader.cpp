@@ -20,6 +20,7 @@
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/NestedNameSpecifier.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
 #include "clang/Basic/FileManager.h"
@@ -27,6 +28,7 @@
 #include "clang/Basic/SourceManagerInternals.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/TargetOptions.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Basic/Version.h"
 #include "clang/Basic/VersionTuple.h"
 #include "clang/Lex/HeaderSearch.h"
@@ -2515,6 +2517,11 @@ bool ASTReader::ReadASTBlock(ModuleFile &F) {
       }
       break;
 
+    case RECORD_LAYOUTS:
+      // The layouts are indexed and decoded when a record is first laid out.
+      F.RecordLayouts.swap(Record);
+      break;
+
     case IMPORTED_MODULES: {
       if (F.Kind != MK_Module) {
         // If we aren't loading a module (which has its own exports), make
@@ -2747,6 +2754,8 @@ ASTReader::ASTReadResult ASTReader::ReadAST(const std::string &FileName,
                                             ModuleKind Type,
                                             SourceLocation ImportLoc,
                                             unsigned ClientLoadCapabilities) {
+  TimeTraceScope Trace("ReadAST", FileName);
+
   // Bump the generation number.
   unsigned PreviousGeneration = CurrentGeneration++;
 
@@ -4158,6 +4167,7 @@ void ASTReader::ReadPragmaDiagnosticMappings(DiagnosticsEngine &Diag) {
         diag::Mapping Map = (diag::Mapping)F.PragmaDiagMappings[Idx++];
         DiagnosticMappingInfo MappingInfo = Diag.makeMappingInfo(Map, Loc);
         Diag.GetCurDiagState()->setMappingInfo(DiagID, MappingInfo);
+        Diag.noteIgnoredEverywhereNewState(DiagID, MappingInfo);
       }
     }
   }
@@ -6003,6 +6013,91 @@ void ASTReader::ReadKnownNamespaces(
   }
 }
 
+const ASTRecordLayout *
+ASTReader::getStoredRecordLayout(const RecordDecl *Record) {
+  ModuleFile *Owner = getOwningModuleFile(Record);
+  if (!Owner || Owner->RecordLayouts.empty())
+    return 0;
+
+  ModuleFile &F = *Owner;
+  const SmallVectorImpl<uint64_t> &Layout = F.RecordLayouts;
+  if (F.RecordLayoutPositions.empty()) {
+    // Note where each layout starts.
+    for (unsigned I = 0, N = Layout.size(); I + 4 < N; /* in loop */) {
+      F.RecordLayoutPositions[Layout[I]] = I + 1;
+      I += 4;                           // ID, size, data size, alignment.
+      I += Layout[I] + 1;               // Fields.
+      if (I >= N || !Layout[I++])       // C++ information.
+        continue;
+      I += 7;                           // Everything but the bases.
+      if (I >= N)
+        break;
+      I += 2 * Layout[I] + 1;           // Non-virtual bases.
+      if (I >= N)
+        break;
+      I += 3 * Layout[I] + 1;           // Virtual bases.
+    }
+  }
+
+  llvm::DenseMap<DeclID, unsigned>::iterator Pos
+    = F.RecordLayoutPositions.find(
+        mapGlobalIDToModuleFileGlobalID(F, Record->getGlobalID()));
+  if (Pos == F.RecordLayoutPositions.end())
+    return 0;
+
+  unsigned Idx = Pos->second;
+  CharUnits Size = CharUnits::fromQuantity(Layout[Idx++]);
+  CharUnits DataSize = CharUnits::fromQuantity(Layout[Idx++]);
+  CharUnits Alignment = CharUnits::fromQuantity(Layout[Idx++]);
+
+  // Every field must have an offset, so give up on a mismatch rather than
+  // handing back a partial layout.
+  unsigned NumFields = Layout[Idx++];
+  if (NumFields != (unsigned)std::distance(Record->field_begin(),
+                                           Record->field_end()))
+    return 0;
+  const uint64_t *FieldOffsets = Layout.data() + Idx;
+  Idx += NumFields;
+
+  if (!Layout[Idx++])
+    return new (Context) ASTRecordLayout(Context, Size, Alignment, DataSize,
+                                         FieldOffsets, NumFields);
+
+  bool HasOwnVFPtr = Layout[Idx++];
+  CharUnits VBPtrOffset = CharUnits::fromQuantity((int64_t)Layout[Idx++]);
+  CharUnits NonVirtualSize = CharUnits::fromQuantity(Layout[Idx++]);
+  CharUnits NonVirtualAlign = CharUnits::fromQuantity(Layout[Idx++]);
+  CharUnits SizeOfLargestEmptySubobject
+    = CharUnits::fromQuantity(Layout[Idx++]);
+  const CXXRecordDecl *PrimaryBase = 0;
+  if (uint64_t PrimaryBaseID = Layout[Idx++])
+    PrimaryBase = cast<CXXRecordDecl>(GetDecl(getGlobalDeclID(F,
+                                                              PrimaryBaseID)));
+  bool IsPrimaryBaseVirtual = Layout[Idx++];
+
+  ASTRecordLayout::BaseOffsetsMapTy BaseOffsets;
+  for (unsigned NumBases = Layout[Idx++]; NumBases; --NumBases) {
+    const CXXRecordDecl *Base
+      = cast<CXXRecordDecl>(GetDecl(getGlobalDeclID(F, Layout[Idx++])));
+    BaseOffsets[Base] = CharUnits::fromQuantity(Layout[Idx++]);
+  }
+  ASTRecordLayout::VBaseOffsetsMapTy VBaseOffsets;
+  for (unsigned NumVBases = Layout[Idx++]; NumVBases; --NumVBases) {
+    const CXXRecordDecl *Base
+      = cast<CXXRecordDecl>(GetDecl(getGlobalDeclID(F, Layout[Idx++])));
+    CharUnits Offset = CharUnits::fromQuantity(Layout[Idx++]);
+    VBaseOffsets[Base] = ASTRecordLayout::VBaseInfo(Offset, Layout[Idx++]);
+  }
+
+  return new (Context) ASTRecordLayout(Context, Size, Alignment, HasOwnVFPtr,
+                                       VBPtrOffset, DataSize, FieldOffsets,
+                                       NumFields, NonVirtualSize,
+                                       NonVirtualAlign,
+                                       SizeOfLargestEmptySubobject,
+                                       PrimaryBase, IsPrimaryBaseVirtual,
+                                       BaseOffsets, VBaseOffsets);
+}
+
 void ASTReader::ReadUndefinedButUsed(
                         llvm::DenseMap<NamedDecl*, SourceLocation> &Undefined) {
   for (unsigned Idx = 0, N = UndefinedButUsed.size(); Idx != N;) {
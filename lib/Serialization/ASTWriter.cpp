@@ -20,6 +20,7 @@
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
 #include "clang/Basic/FileManager.h"
@@ -825,6 +826,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DELEGATING_CTORS);
   RECORD(KNOWN_NAMESPACES);
   RECORD(UNDEFINED_BUT_USED);
+  RECORD(RECORD_LAYOUTS);
   RECORD(MODULE_OFFSET_MAP);
   RECORD(SOURCE_MANAGER_LINE_TABLE);
   RECORD(OBJC_CATEGORIES_MAP);
@@ -2418,6 +2420,89 @@ void ASTWriter::WriteComments() {
   Stream.ExitBlock();
 }
 
+/// \brief Write the layouts of the records defined in this AST file, so that
+/// translation units using the AST file need not lay them out again.
+void ASTWriter::WriteRecordLayouts() {
+  // Laying out a record can emit -Wpadded and -Wpacked; don't lay out records
+  // nobody uses just to store them. Readers with these warnings enabled lay
+  // records out themselves anyway.
+  if (Context->mayDiagnoseRecordLayout())
+    return;
+
+  // Collect the complete, non-dependent record definitions we have written,
+  // in declaration ID order so the output does not depend on pointer values.
+  SmallVector<std::pair<DeclID, const RecordDecl *>, 16> Records;
+  for (llvm::DenseMap<const Decl *, DeclID>::iterator I = DeclIDs.begin(),
+                                                      E = DeclIDs.end();
+       I != E; ++I) {
+    const RecordDecl *RD = dyn_cast<RecordDecl>(I->first);
+    if (!RD || RD->isFromASTFile() || !RD->isCompleteDefinition() ||
+        RD->isInvalidDecl() || RD->isDependentType())
+      continue;
+    Records.push_back(std::make_pair(I->second, RD));
+  }
+  if (Records.empty())
+    return;
+  std::sort(Records.begin(), Records.end());
+
+  RecordData Record;
+  for (unsigned I = 0, N = Records.size(); I != N; ++I) {
+    const RecordDecl *RD = Records[I].second;
+    const ASTRecordLayout &Layout = Context->getASTRecordLayout(RD);
+
+    Record.push_back(Records[I].first);
+    Record.push_back(Layout.getSize().getQuantity());
+    Record.push_back(Layout.getDataSize().getQuantity());
+    Record.push_back(Layout.getAlignment().getQuantity());
+    Record.push_back(Layout.getFieldCount());
+    for (unsigned Field = 0, NumFields = Layout.getFieldCount();
+         Field != NumFields; ++Field)
+      Record.push_back(Layout.getFieldOffset(Field));
+
+    const CXXRecordDecl *CXXRD = dyn_cast<CXXRecordDecl>(RD);
+    Record.push_back(CXXRD != 0);
+    if (!CXXRD)
+      continue;
+
+    Record.push_back(Layout.hasOwnVFPtr());
+    Record.push_back((uint64_t)Layout.getVBPtrOffset().getQuantity());
+    Record.push_back(Layout.getNonVirtualSize().getQuantity());
+    Record.push_back(Layout.getNonVirtualAlign().getQuantity());
+    Record.push_back(Layout.getSizeOfLargestEmptySubobject().getQuantity());
+    if (const CXXRecordDecl *PrimaryBase = Layout.getPrimaryBase())
+      Record.push_back(getDeclID(PrimaryBase));
+    else
+      Record.push_back(0);
+    Record.push_back(Layout.isPrimaryBaseVirtual());
+
+    unsigned NumBasesIdx = Record.size();
+    Record.push_back(0);
+    for (CXXRecordDecl::base_class_const_iterator B = CXXRD->bases_begin(),
+                                                  BEnd = CXXRD->bases_end();
+         B != BEnd; ++B) {
+      if (B->isVirtual())
+        continue;
+      const CXXRecordDecl *Base = B->getType()->getAsCXXRecordDecl();
+      Record.push_back(getDeclID(Base));
+      Record.push_back(Layout.getBaseClassOffset(Base).getQuantity());
+      ++Record[NumBasesIdx];
+    }
+
+    Record.push_back(CXXRD->getNumVBases());
+    for (CXXRecordDecl::base_class_const_iterator B = CXXRD->vbases_begin(),
+                                                  BEnd = CXXRD->vbases_end();
+         B != BEnd; ++B) {
+      const CXXRecordDecl *Base = B->getType()->getAsCXXRecordDecl();
+      const ASTRecordLayout::VBaseInfo &Info
+        = Layout.getVBaseOffsetsMap().find(Base)->second;
+      Record.push_back(getDeclID(Base));
+      Record.push_back(Info.VBaseOffset.getQuantity());
+      Record.push_back(Info.HasVtorDisp);
+    }
+  }
+  Stream.EmitRecord(RECORD_LAYOUTS, Record);
+}
+
 //===----------------------------------------------------------------------===//
 // Global Method Pool and Selector Serialization
 //===----------------------------------------------------------------------===//
@@ -3667,6 +3752,7 @@ void ASTWriter::WriteASTCore(Sema &SemaRef,
   WriteFileDeclIDsMap();
   WriteSourceManagerBlock(Context.getSourceManager(), PP, isysroot);
   WriteComments();
+  WriteRecordLayouts();
   
   if (Chain) {
     // Write the mapping information describing our module dependencies and how
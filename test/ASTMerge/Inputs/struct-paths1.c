@@ -0,0 +1,17 @@
+struct Inner { int a; float b; };
+
+// Records that reach Inner through several paths
+struct Outer1 { struct Inner i; struct Inner *p; };
+struct Outer2 { struct Outer1 o; struct Inner i; };
+
+// Mismatch in a record that contains Inner
+struct Mismatch { struct Inner i; int c; };
+
+// Pointer to a tag that has no definition in this translation unit
+struct Fwd;
+struct UsesFwd { struct Fwd *f; };
+
+struct Outer1 x1;
+struct Outer2 x2;
+struct Mismatch x3;
+struct UsesFwd x4;
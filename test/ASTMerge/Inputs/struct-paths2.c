@@ -0,0 +1,18 @@
+struct Inner { int a; float b; };
+
+// Records that reach Inner through several paths
+struct Outer1 { struct Inner i; struct Inner *p; };
+struct Outer2 { struct Outer1 o; struct Inner i; };
+
+// Mismatch in a record that contains Inner
+struct Mismatch { struct Inner i; float c; };
+
+// UsesFwd is compared while Fwd is still incomplete in the merged AST
+struct UsesFwd { struct Fwd *f; };
+struct Fwd { int x; };
+
+struct Outer2 x2;
+struct Outer1 x1;
+struct Mismatch x3;
+struct UsesFwd x4;
+struct Fwd x5;
@@ -0,0 +1,3 @@
+// Mismatch with the definition of Fwd merged from struct-paths2.c
+struct Fwd { float x; };
+struct Fwd x5;
@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -emit-pch -o %t.1.ast %S/Inputs/struct-paths1.c
+// RUN: %clang_cc1 -emit-pch -o %t.2.ast %S/Inputs/struct-paths2.c
+// RUN: %clang_cc1 -emit-pch -o %t.3.ast %S/Inputs/struct-paths3.c
+// RUN: %clang_cc1 -ast-merge %t.1.ast -ast-merge %t.2.ast -ast-merge %t.3.ast -fsyntax-only %s 2>&1 | FileCheck -check-prefix=SHARED %s
+// RUN: %clang_cc1 -ast-merge %t.1.ast -ast-merge %t.2.ast -ast-merge %t.3.ast -fsyntax-only %s 2>&1 | FileCheck -check-prefix=MISMATCH %s
+// RUN: %clang_cc1 -ast-merge %t.1.ast -ast-merge %t.2.ast -ast-merge %t.3.ast -fsyntax-only %s 2>&1 | FileCheck -check-prefix=FWD %s
+
+// Inner is proven equivalent once and reached again through the other
+// records, which must all merge cleanly.
+// SHARED-NOT: 'struct Inner'
+// SHARED-NOT: 'struct Outer1'
+// SHARED-NOT: 'struct Outer2'
+// SHARED-NOT: 'struct UsesFwd'
+// SHARED: 2 errors generated
+
+// A remembered equivalence of Inner must not hide a mismatch next to it.
+// MISMATCH: struct-paths1.c:8:8: warning: type 'struct Mismatch' has incompatible definitions in different translation units
+// MISMATCH: struct-paths2.c:16:17: error: external variable 'x3' declared with incompatible types in different translation units ('struct Mismatch' vs. 'struct Mismatch')
+
+// UsesFwd was first compared while Fwd had no definition. That comparison is
+// not remembered, and the later definitions of Fwd are still checked.
+// FWD: warning: type 'struct Fwd' has incompatible definitions in different translation units
+// FWD: struct-paths3.c:3:12: error: external variable 'x5' declared with incompatible types in different translation units ('struct Fwd' vs. 'struct Fwd')
@@ -0,0 +1,12 @@
+// RUN: %clang_cc1 -fsyntax-only -ast-memory-stats-json %t %s
+// RUN: FileCheck < %t %s
+
+template<typename T> T twice(T t) { return t + t; }
+int f() { return twice(21); }
+
+// CHECK: "allocated":
+// CHECK: "attributed":
+// CHECK: "origins": {"main file": {{[1-9][0-9]*}}, "headers": 0, "template instantiations": {{[1-9][0-9]*}}, "AST files": 0, "other":
+// CHECK: "kinds": [
+// CHECK-DAG: {"kind": "FunctionTemplate", "category": "decl", "count": 1,
+// CHECK-DAG: {"kind": "ReturnStmt", "category": "stmt", "count": 3,
@@ -0,0 +1,14 @@
+// REQUIRES: system-linux
+// RUN: %clang_cc1 -I %S/Inputs -dependency-file %t.d -MT %t.o -fsyntax-only %s
+// RUN: %clang_cc1 -I %S/Inputs -prefetch-dependencies %t.d -print-stats -fsyntax-only %s 2>&1 | FileCheck -check-prefix=DEPS %s
+// RUN: %clang_cc1 -I %S/Inputs -prefetch-dependencies %t.missing -fsyntax-only %s
+// RUN: %clang_cc1 -I %S/Inputs -print-stats -fsyntax-only %s 2>&1 | FileCheck -check-prefix=NONE %s
+
+// The dependency file lists this file, test.h and test2.h.
+// DEPS: 3 files prefetched.
+
+// NONE: 0 files prefetched.
+
+#include "test.h"
+
+int y = x;
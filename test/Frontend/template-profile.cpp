@@ -0,0 +1,34 @@
+// RUN: %clang_cc1 -fsyntax-only -print-template-profile \
+// RUN:   -template-profile-trace %t %s 2>&1 | FileCheck %s
+// RUN: FileCheck -check-prefix=TRACE %s < %t
+
+namespace N {
+  template<typename T> struct Box {
+    T Value;
+    T get() const { return Value; }
+  };
+}
+
+template<typename T> T unbox(const N::Box<T> &B) { return B.get(); }
+
+int use(N::Box<int> B) { return unbox(B); }
+
+// CHECK: *** Template Instantiation Profile:
+// CHECK: instantiations took {{.*}} seconds and allocated {{[0-9]+}} bytes of AST.
+// CHECK: Specializations ({{[0-9]+}} total):
+// CHECK-DAG: class N::Box<int>
+// CHECK-DAG: function N::Box<int>::get
+// CHECK-DAG: function unbox<int>
+// CHECK-DAG: deduction unbox
+// CHECK: Templates ({{[0-9]+}} total):
+// CHECK-DAG: {{ N::Box$}}
+// CHECK-DAG: {{ N::Box::get$}}
+// CHECK-DAG: {{ unbox$}}
+// CHECK: Files (1 total):
+// CHECK-NEXT: Self(s)
+// CHECK-NEXT: template-profile.cpp
+
+// TRACE: {"traceEvents":[
+// TRACE-DAG: {"name":"N::Box<int>","cat":"class","ph":"X",{{.*}}"args":{"template":"N::Box","bytes":{{[0-9]+}}}}
+// TRACE-DAG: {"name":"unbox<int>","cat":"function","ph":"X",{{.*}}"args":{"template":"unbox",
+// TRACE: ]}
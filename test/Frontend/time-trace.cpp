@@ -0,0 +1,26 @@
+// RUN: %clang_cc1 -emit-llvm -o /dev/null -time-trace-file %t %s
+// RUN: FileCheck %s < %t
+// RUN: %clang -### -c -ftime-trace %s -o %t.o 2>&1 \
+// RUN:   | FileCheck -check-prefix=DRIVER %s
+
+namespace N {
+  template<typename T> struct Box {
+    T Value;
+    T get() const { return Value; }
+  };
+}
+
+int use(N::Box<int> B) { return B.get(); }
+
+// CHECK: {"traceEvents":[
+// CHECK-DAG: {"name":"N::Box<int>","cat":"class","ph":"X",{{.*}}"args":{"template":"N::Box","bytes":{{[0-9]+}}}}
+// CHECK-DAG: {"name":"N::Box<int>::get","cat":"function","ph":"X",{{.*}}"args":{"template":"N::Box::get",
+// CHECK-DAG: {"name":"ParseTopLevelDecl","ph":"X",{{.*}}"args":{"detail":"N"}}
+// CHECK-DAG: {"name":"ParseTopLevelDecl","ph":"X",{{.*}}"args":{"detail":"use"}}
+// CHECK-DAG: {"name":"PerformPendingInstantiations","ph":"X",
+// CHECK-DAG: {"name":"CodeGen","ph":"X",
+// CHECK-DAG: {"name":"Backend","ph":"X",
+// CHECK-DAG: {"name":"ExecuteCompiler","ph":"X",{{.*}}"args":{"detail":"{{.*}}time-trace.cpp"}}
+// CHECK: ]}
+
+// DRIVER: "-time-trace-file" "{{.*}}time-trace.cpp.tmp.json"
@@ -0,0 +1,24 @@
+// Note: the run lines follow their respective tests, since line/column
+// matter in this test.
+
+int foo_bar;
+int foo_baz;
+int other;
+
+int f(void) {
+  return foo_b;
+}
+
+// Repeated completions at the same location are answered by filtering the
+// results of the first one by the identifier after the completion location.
+// RUN: env CINDEXTEST_EDITING=1 CINDEXTEST_COMPLETION_FILTER_CACHED=1 c-index-test -code-completion-at=%s:9:10 "-remap-file=%s;%s" %s | FileCheck -check-prefix=CHECK-FILTERED %s
+// CHECK-FILTERED: VarDecl:{ResultType int}{TypedText foo_bar} (50)
+// CHECK-FILTERED: VarDecl:{ResultType int}{TypedText foo_baz} (50)
+// CHECK-FILTERED-NOT: other
+// CHECK-FILTERED: Completion contexts:
+
+// Without the option, every result is returned.
+// RUN: env CINDEXTEST_EDITING=1 c-index-test -code-completion-at=%s:9:10 "-remap-file=%s;%s" %s | FileCheck -check-prefix=CHECK-ALL %s
+// CHECK-ALL: VarDecl:{ResultType int}{TypedText foo_bar} (50)
+// CHECK-ALL: VarDecl:{ResultType int}{TypedText foo_baz} (50)
+// CHECK-ALL: VarDecl:{ResultType int}{TypedText other} (50)
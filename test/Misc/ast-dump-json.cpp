@@ -0,0 +1,29 @@
+// RUN: %clang_cc1 -ast-dump-json %s | FileCheck %s
+// RUN: %clang_cc1 -ast-dump-json -ast-dump-filter N::f %s \
+// RUN:   | FileCheck -check-prefix=NAME %s
+// RUN: %clang_cc1 -ast-dump-json -ast-dump-kind-filter CXXMethodDecl %s \
+// RUN:   | FileCheck -check-prefix=KIND %s
+// RUN: %clang_cc1 -ast-dump-json -ast-dump-file-filter no-such-file %s \
+// RUN:   | FileCheck -allow-empty -check-prefix=FILE %s
+
+namespace N {
+  int f(int x) { return x + 1; }
+  struct S {
+    int m() const { return "a\"b"[0]; }
+  };
+}
+
+// Every top-level declaration is written as one record per line, and the
+// members of a namespace are split into their own records.
+// CHECK: {"kind":"NamespaceDecl","file":"{{.*}}ast-dump-json.cpp","line":9,"col":11,"name":"N"}
+// CHECK-NEXT: {"kind":"FunctionDecl","file":"{{.*}}ast-dump-json.cpp","line":10,"col":7,"name":"f","type":"int (int)","inner":[{"kind":"ParmVarDecl","line":10,"col":13,"name":"x","type":"int"},{"kind":"CompoundStmt",{{.*}}"opcode":"+"{{.*}}"kind":"IntegerLiteral",{{.*}}"value":"1"
+// CHECK-NEXT: {"kind":"CXXRecordDecl",{{.*}}"name":"S"{{.*}}"kind":"StringLiteral",{{.*}}"value":"a\"b"
+
+// NAME-NOT: "kind":"NamespaceDecl"
+// NAME: {"kind":"FunctionDecl",{{.*}}"name":"f"
+// NAME-NOT: CXXRecordDecl
+
+// KIND: {"kind":"CXXMethodDecl",{{.*}}"name":"m","type":"int () const"
+// KIND-NOT: "kind":"FunctionDecl"
+
+// FILE-NOT: kind
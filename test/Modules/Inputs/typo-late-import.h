@@ -0,0 +1 @@
+int late_imported_variable;
@@ -0,0 +1,17 @@
+// RUN: rm -rf %t
+// RUN: %clang_cc1 -fmodules -fmodules-cache-path=%t -I %S/Inputs %s -verify
+
+// The names of modules imported after the first typo correction must still
+// be suggested.
+@import diamond_top;
+
+int early(void) {
+  return undeclared_variable; // expected-error{{use of undeclared identifier 'undeclared_variable'}}
+}
+
+@import typo_late_import;
+
+int late(void) {
+  return late_imported_varible; // expected-error{{use of undeclared identifier 'late_imported_varible'; did you mean 'late_imported_variable'?}}
+  // in other file: expected-note@1{{'late_imported_variable' declared here}}
+}
@@ -0,0 +1,31 @@
+// Test this without pch.
+// RUN: %clang_cc1 -include %s -fsyntax-only -ast-memory-stats-json %t.nopch.json %s
+// RUN: FileCheck -check-prefix=NOPCH < %t.nopch.json %s
+
+// Test with pch.
+// RUN: %clang_cc1 -x c++-header -emit-pch -o %t.pch %s
+// RUN: %clang_cc1 -include-pch %t.pch -fsyntax-only -ast-memory-stats-json %t.pch.json %s
+// RUN: FileCheck -check-prefix=PCH < %t.pch.json %s
+
+#ifndef HEADER
+#define HEADER
+
+inline int used() { return 1; }
+inline int unused1() { return 2; }
+inline int unused2() { return 3; }
+inline int unused3() { return 4; }
+
+#else
+
+int f() { return used(); }
+
+#endif
+
+// Only the declarations used by the main file are deserialized and counted,
+// and not the body of 'used'.
+// NOPCH: "origins": {"main file": {{[1-9][0-9]*}}, "headers": {{[1-9][0-9]*}}, "template instantiations": 0, "AST files": 0, "other":
+// NOPCH-DAG: {"kind": "Function", "category": "decl", "count": 5,
+// NOPCH-DAG: {"kind": "ReturnStmt", "category": "stmt", "count": 5,
+// PCH: "origins": {"main file": {{[1-9][0-9]*}}, "headers": 0, "template instantiations": 0, "AST files": {{[1-9][0-9]*}}, "other":
+// PCH-DAG: {"kind": "Function", "category": "decl", "count": 2,
+// PCH-DAG: {"kind": "ReturnStmt", "category": "stmt", "count": 1,
@@ -0,0 +1,40 @@
+// Test this without pch.
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -include %s -emit-llvm -o - %s | FileCheck %s
+
+// Test with pch.
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -emit-pch -o %t %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -include-pch %t -emit-llvm -o - %s | FileCheck %s
+
+// Builtins are initialized even when a PCH is used. Builtins referenced by
+// the PCH keep the ID they were stored with, and builtins that only the main
+// file references are recognized when their identifier is first created.
+
+#ifndef HEADER
+#define HEADER
+
+unsigned long strlen(const char *);
+
+int header_clz(unsigned x) { return __builtin_clz(x); }
+
+#else
+
+// CHECK: define i32 @header_clz
+// CHECK: call i32 @llvm.ctlz.i32
+
+// CHECK: define i32 @main_clz
+// CHECK: call i32 @llvm.ctlz.i32
+int main_clz(unsigned x) { return __builtin_clz(x); }
+
+// CHECK: define i32 @main_popcount
+// CHECK: call i32 @llvm.ctpop.i32
+int main_popcount(unsigned x) { return __builtin_popcount(x); }
+
+// CHECK: define i32 @main_strlen
+// CHECK: ret i32 4
+int main_strlen(void) { return strlen("abcd"); }
+
+// CHECK: define i32 @main_builtin_strlen
+// CHECK: ret i32 3
+int main_builtin_strlen(void) { return __builtin_strlen("abc"); }
+
+#endif
@@ -0,0 +1,53 @@
+// Test that record layouts stored in a chained PCH are reloaded correctly,
+// including layouts whose bases come from an earlier PCH in the chain.
+
+// Without PCH
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include %s -include %s %s -emit-llvm -o %t.withoutpch.ll
+
+// With PCH
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -chain-include %s -chain-include %s %s -emit-llvm -o %t.withpch.ll
+// RUN: diff %t.withoutpch.ll %t.withpch.ll
+
+#ifndef HEADER1
+#define HEADER1
+//===----------------------------------------------------------------------===//
+// Primary header
+
+struct A { char c; int i; };
+struct V { virtual void f(); short s; };
+struct B : A, virtual V { char b; };
+
+//===----------------------------------------------------------------------===//
+#elif not defined(HEADER2)
+#define HEADER2
+#if !defined(HEADER1)
+#error Header inclusion order messed up
+#endif
+
+//===----------------------------------------------------------------------===//
+// Dependent header
+
+struct C : B { long long l; };
+struct D : virtual V, C { char d; };
+struct E { A a; C c; int e; };
+
+//===----------------------------------------------------------------------===//
+#else
+//===----------------------------------------------------------------------===//
+
+unsigned long sizes[] = {
+  sizeof(A), sizeof(V), sizeof(B), sizeof(C), sizeof(D), sizeof(E),
+  __alignof(D)
+};
+
+unsigned long offsets[] = {
+  __builtin_offsetof(A, i), __builtin_offsetof(E, c),
+  __builtin_offsetof(E, e)
+};
+
+int get(D &d) { return d.i + d.s + d.b + d.l + d.d; }
+V *toV(D *d) { return d; }
+A *toA(D *d) { return d; }
+
+//===----------------------------------------------------------------------===//
+#endif
@@ -0,0 +1,37 @@
+// Test with PCH
+// RUN: %clang_cc1 -x c++-header -emit-pch -o %t %s
+// RUN: %clang_cc1 -include-pch %t -verify %s
+// RUN: %clang_cc1 -include-pch %t -ast-print %s | FileCheck %s
+// expected-no-diagnostics
+
+// Check that references to operator and conversion function names, which
+// carry extra location info, survive a round trip through a PCH.
+
+#ifndef HEADER
+#define HEADER
+
+struct X {
+  int value;
+  X operator+(const X &other) const;
+  operator int() const { return value; }
+};
+
+X operator-(const X &lhs, const X &rhs);
+
+inline int use(X a, X b) {
+  X c = a.operator+(b);
+  X d = operator-(a, b);
+  return c.operator int() + d.value + (a + b).value;
+}
+
+#else
+
+int test(X a, X b) {
+  return use(a, b);
+}
+
+// CHECK: X c = a.operator+(b);
+// CHECK: X d = operator-(a, b);
+// CHECK: return c.operator int() + d.value + (a + b).value;
+
+#endif
@@ -0,0 +1,29 @@
+// Test this without pch.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 %s -include %s.h -emit-llvm -o %t.withoutpch.ll
+
+// Test with pch.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -x c++-header %s.h -emit-pch -o %t.pch
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 %s -include-pch %t.pch -emit-llvm -o %t.withpch.ll
+// RUN: diff %t.withoutpch.ll %t.withpch.ll
+
+// The stored layouts are bypassed when -Wpadded may fire, so records from the
+// PCH are still diagnosed, and writing the PCH doesn't lay out (and diagnose)
+// every record.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -x c++-header %s.h -emit-pch -o %t.padded.pch -Wpadded -verify
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 %s -include-pch %t.pch -Wpadded -fsyntax-only 2>&1 | FileCheck -check-prefix=PADDED %s
+// PADDED: record-layout.cpp.h:3:{{.*}}warning: padding struct 'A' with 3 bytes to align 'i'
+
+// The layouts stored in the PCH must match the ones computed from scratch.
+unsigned long sizes[] = {
+  sizeof(A), sizeof(B), sizeof(C), sizeof(D), sizeof(E), sizeof(Bits),
+  __alignof(D), __alignof(Packed), sizeof(Packed)
+};
+
+unsigned long offsets[] = {
+  __builtin_offsetof(A, i), __builtin_offsetof(Bits, c),
+  __builtin_offsetof(Packed, i)
+};
+
+int get(D &d) { return d.B::i + d.s + d.d + d.l; }
+int getBits(Bits &b) { return b.a + b.b; }
+C *toC(E *e) { return e; }
@@ -0,0 +1,15 @@
+// Header for PCH test record-layout.cpp
+
+struct A { char c; int i; };
+struct B : A { virtual void f(); short s; };
+struct C : virtual A { char d; };
+struct D : B, C { long long l; };
+struct E : virtual C, virtual B { };
+
+struct Bits { unsigned a : 3; unsigned b : 7; char c; };
+
+#pragma pack(push, 1)
+struct Packed { char c; int i; };
+#pragma pack(pop)
+
+// expected-no-diagnostics
@@ -0,0 +1,42 @@
+// RUN: %clang_cc1 -fsyntax-only -Wno-vexing-parse -verify %s
+// RUN: %clang_cc1 -fsyntax-only -Wno-vexing-parse -print-stats %s 2>&1 | FileCheck %s
+// expected-no-diagnostics
+
+// The results of ambiguity resolution are memoized; make sure that they
+// still follow what the names refer to.
+
+struct S { S(); S(int); int n; };
+typedef int T;
+
+void f(int a) {
+  S(x);
+  x.n = a;
+  S(a).n = 0;
+  S y(T(a));
+  S w((T(a)));
+  w.n = sizeof(S(T(a)));
+}
+
+int V(int);
+
+void g(int b) {
+  {
+    typedef S V;
+    V(c);
+    c.n = b;
+  }
+  V(b);
+}
+
+void h(int a) {
+  // The parameter lists of these declarators are disambiguated while the
+  // statement is tentatively parsed, and again when it is parsed for real;
+  // the second time the result must come from the cache.
+  S(p)(T(a));
+  S(q)(T(a), T(b));
+}
+
+// CHECK: *** Parser Stats:
+// CHECK: {{[1-9][0-9]*}} ambiguities resolved by tentative parsing, {{[1-9][0-9]*}} from the cache.
+// CHECK: *** Preprocessor Stats:
+// CHECK: {{[1-9][0-9]*}} tokens backtracked.
@@ -0,0 +1,27 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify %s
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -fdelayed-inline-method-parsing -DDELAYED -verify %s
+// RUN: not %clang_cc1 -std=c++11 -fdelayed-inline-method-parsing -emit-llvm -o - %s 2>&1 | FileCheck -check-prefix=CODEGEN %s
+
+// Bodies parsed at the end of the translation unit see the declarations that
+// follow the class, so overload resolution in them can pick another function.
+// This is why the mode is rejected when generating code.
+
+#if DELAYED
+// expected-note@19 {{candidate function}}
+// expected-error@22 {{call to deleted function 'h'}}
+// expected-note@25 {{candidate function has been explicitly deleted}}
+#else
+// expected-no-diagnostics
+#endif
+
+// CODEGEN: error: invalid argument '-fdelayed-inline-method-parsing' not allowed with '-emit-llvm'
+
+void h(long);
+
+struct B {
+  void f() { h(0); }
+};
+
+void h(int) = delete;
+
+void use(B &b) { b.f(); }
@@ -0,0 +1,22 @@
+// RUN: %clang_cc1 -fsyntax-only -fdelayed-inline-method-parsing -Wunused-private-field -Wunused-function -Wunused-variable -verify %s
+
+// The bodies of unused inline methods are never parsed, so the private fields
+// and file scope declarations they name must not be diagnosed as unused.
+
+static int helper() { return 0; }
+static int counter;
+static int really_unused() { return 0; } // expected-warning {{unused function 'really_unused'}}
+
+class A {
+  int field;
+public:
+  int get() { return field + helper() + counter; }
+};
+
+class B {
+  int field; // expected-warning {{private field 'field' is not used}}
+public:
+  int get();
+};
+
+int B::get() { return 0; }
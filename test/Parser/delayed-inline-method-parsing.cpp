@@ -0,0 +1,28 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -fdelayed-inline-method-parsing -verify %s
+
+// The bodies of inline methods are only parsed if the methods are used.
+
+struct A {
+  void unused() { undeclared1(); }
+  int used() { return undeclared2(); } // expected-error {{use of undeclared identifier 'undeclared2'}}
+  int indirect() { return undeclared3; } // expected-error {{use of undeclared identifier 'undeclared3'}}
+  int calls_indirect() { return indirect(); }
+  int only_called_by_unused() { return undeclared4; }
+  int calls_unused() { return only_called_by_unused(); }
+  constexpr static int c() { return 1; }
+  int later() { return member; }
+  int member;
+};
+
+template<typename T> int call_used(T &t) { return t.used(); }
+
+int f(A &a) {
+  static_assert(A::c() == 1, "constexpr bodies are parsed eagerly");
+  return call_used(a) + a.calls_indirect() + a.later();
+}
+
+void g() {
+  struct Local {
+    int local() { return undeclared5; } // expected-error {{use of undeclared identifier 'undeclared5'}}
+  };
+}
@@ -0,0 +1,15 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+// -Wshadow is off by default. Check that asking for its level before any
+// pragma enables it doesn't keep it ignored once a pragma does.
+
+int x; // expected-note {{previous declaration is here}}
+
+void f1(void) { int x = 0; (void)x; }
+
+#pragma clang diagnostic push
+#pragma clang diagnostic warning "-Wshadow"
+void f2(void) { int x = 0; (void)x; } // expected-warning {{declaration shadows a variable in the global scope}}
+#pragma clang diagnostic pop
+
+void f3(void) { int x = 0; (void)x; }
@@ -0,0 +1,24 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -fsyntax-only -ftypo-correction-budget 1 -DBUDGET -verify %s
+// RUN: not %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+// RUN: not %clang_cc1 -fsyntax-only -ftypo-correction-budget 1 -print-stats %s 2>&1 | FileCheck -check-prefix=BUDGET %s
+
+// Names of the same length as the typo are compared first, and there are
+// several five-letter keywords, so a budget of one name never reaches
+// 'value_'.
+
+#ifdef BUDGET
+int value_;
+int f() { return valeu; } // expected-error {{use of undeclared identifier 'valeu'}}
+#else
+int value_; // expected-note {{'value_' declared here}}
+int f() { return valeu; } // expected-error {{use of undeclared identifier 'valeu'; did you mean 'value_'?}}
+#endif
+
+// CHECK: *** Typo Correction Index Stats:
+// CHECK: {{[0-9]+}} names indexed.
+// CHECK: {{[1-9][0-9]*}} lookups, {{[1-9][0-9]*}} names compared, {{[1-9][0-9]*}} names skipped.
+// CHECK: 0 lookups exceeded the typo correction budget.
+
+// BUDGET: *** Typo Correction Index Stats:
+// BUDGET: {{[1-9][0-9]*}} lookups exceeded the typo correction budget.
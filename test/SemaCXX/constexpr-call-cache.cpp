@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s -fconstexpr-cache-size 0 2>&1 | FileCheck -check-prefix=NO-CACHE %s
+// expected-no-diagnostics
+
+// Each of fib(3) ... fib(20) finds fib(n - 2) in the cache, once fib(n - 1)
+// has been evaluated.
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+static_assert(fib(20) == 6765, "");
+
+struct Pair { int a, b; };
+constexpr Pair swap(Pair p) { return Pair{p.b, p.a}; }
+constexpr Pair twice(Pair p) { return swap(swap(p)); }
+static_assert(twice(Pair{1, 2}).a == 1 && swap(Pair{1, 2}).a == 2, "");
+
+// Calls which read through a pointer are not memoized, but still work.
+constexpr int load(const int *p) { return *p; }
+constexpr int values[] = { 4, 5 };
+static_assert(load(values) + load(values + 1) == 9, "");
+
+// CHECK: {{(1[89]|[2-9][0-9]|[1-9][0-9][0-9]+)}}/{{[0-9]+}} constexpr calls answered from the call cache ({{[1-9][0-9]*}} entries)
+// NO-CACHE: 0/0 constexpr calls answered from the call cache (0 entries)
@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s -fconstexpr-steps 100 -fconstexpr-cache-size 0 -fconstexpr-backtrace-limit 2
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s -fconstexpr-steps 0 -fconstexpr-cache-size 0 -DNO_LIMIT
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s -fconstexpr-steps 0 -DNO_LIMIT 2>&1 | FileCheck %s
+
+// Each call costs three steps: the call, the body and the return statement.
+// With a budget of 100 steps, the 34th nested call, count(27), runs out when
+// it enters its body.
+
+#ifdef NO_LIMIT
+// expected-no-diagnostics
+constexpr int count(int n) { return n ? 1 + count(n - 1) : 0; }
+#else
+constexpr int count(int n) { return n ? 1 + count(n - 1) : 0; } // expected-note {{constexpr evaluation hit maximum step limit of 100}} expected-note {{in call to 'count(27)'}} expected-note {{(skipping 32 calls in backtrace; use -fconstexpr-backtrace-limit=0 to see all)}}
+#endif
+
+static_assert(count(10) == 10, "");
+#ifdef NO_LIMIT
+static_assert(count(60) == 60, "");
+#else
+static_assert(count(60) == 60, ""); // expected-error {{not an integral constant expression}} expected-note {{in call to 'count(60)'}}
+#endif
+
+// Calls answered from the call cache are charged one step each; the steps
+// their first evaluation took are reported separately.
+constexpr int twice(int n) { return count(n) + count(n); }
+#ifdef NO_LIMIT
+static_assert(twice(50) == 100, "");
+#endif
+
+// CHECK: {{[0-9]+}} steps taken by {{[0-9]+}} constant evaluations
+// CHECK-NEXT: {{[1-9][0-9]*}} more steps saved by the constexpr call cache
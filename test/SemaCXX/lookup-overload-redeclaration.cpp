@@ -0,0 +1,29 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+// expected-no-diagnostics
+
+// A redeclaration must replace the declaration it redeclares in the lookup
+// table of its context, while new overloads are just added to the set.
+namespace N {
+  void f(int, int);
+  void f(long);
+  void f(char);
+  template<typename T> void f(T *, int);
+}
+
+// Build the lookup table of N.
+void use1() { N::f(1L); }
+
+namespace N {
+  void f(double);
+  template<typename T> void f(T *, T *);
+  void f(int, int = 0);
+  template<typename T> void f(T *, int = 0);
+}
+
+void use2(int *p) {
+  N::f(1);
+  N::f(p);
+  N::f(p, p);
+  N::f(1.0);
+  N::f('c');
+}
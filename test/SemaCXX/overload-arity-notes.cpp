@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify %s
+
+// Candidates with the wrong number of parameters are rejected before any
+// conversion sequences are computed, but are still described in notes.
+
+void f(int, int); // expected-note {{candidate function not viable: requires 2 arguments, but 3 were provided}}
+void f(int, int, int, int = 0) = delete; // expected-note {{candidate function has been explicitly deleted}}
+void f(int, int, int *); // expected-note {{candidate function not viable: no known conversion from 'int' to 'int *' for 3rd argument}}
+template<typename T> void f(T t); // expected-note {{candidate function template not viable: requires single argument 't', but 3 arguments were provided}}
+template<typename T, typename U> void f(T, U, U, U); // expected-note {{candidate function template not viable: requires 4 arguments, but 3 were provided}}
+
+void test_deleted() {
+  f(1, 2, 3); // expected-error {{call to deleted function 'f'}}
+}
+
+struct S {
+  void g(); // expected-note {{candidate function not viable: requires 0 arguments, but 1 was provided}}
+  void g(int, int); // expected-note {{candidate function not viable: requires 2 arguments, but 1 was provided}}
+  template<typename T> void g(T, T, T); // expected-note {{candidate function template not viable: requires 3 arguments, but 1 was provided}}
+  void g(int *); // expected-note {{candidate function not viable: no known conversion from 'double' to 'int *' for 1st argument}}
+};
+
+void test_member(S s) {
+  s.g(1.0); // expected-error {{no matching member function for call to 'g'}}
+}
+
+// Rejected candidates still count as candidates.
+void h(int x); // expected-note {{candidate function not viable: requires single argument 'x', but 2 arguments were provided}}
+void test_single() {
+  h(1, 2); // expected-error {{no matching function for call to 'h'}}
+}
@@ -0,0 +1,20 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+// Unused private fields are only known at the end of the translation unit,
+// where -Wunused-private-field is ignored again. Fields declared while a
+// pragma enabled it are still diagnosed.
+
+class Before {
+  int unused_;
+};
+
+#pragma clang diagnostic push
+#pragma clang diagnostic warning "-Wunused-private-field"
+class Enabled {
+  int unused_; // expected-warning {{private field 'unused_' is not used}}
+};
+#pragma clang diagnostic pop
+
+class After {
+  int unused_;
+};
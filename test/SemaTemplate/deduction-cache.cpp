@@ -0,0 +1,33 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify %s
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -DSTATS -print-stats %s 2>&1 | FileCheck %s
+
+// Deduction results for a call are reused for later calls with the same
+// argument types, but only when they cannot change as the program grows.
+
+template<typename T> T twice(T t) { return t + t; }
+int ints() { return twice(1) + twice(2) + twice(3); }
+
+// Deduction against a class that is not yet complete does not know its
+// bases, so it must be redone once the class has been defined.
+template<typename T> struct B {};
+template<typename T> int base(B<T> *); // expected-note {{candidate template ignored}}
+
+struct D;
+#ifndef STATS
+int incomplete(D *d) { return base(d); } // expected-error {{no matching function for call to 'base'}}
+#endif
+struct D : B<int> {};
+int complete(D *d) { return base(d) + base(d); }
+
+// Forwarding references deduce differently for lvalues and rvalues.
+template<typename T> struct is_ref { static const bool value = false; };
+template<typename T> struct is_ref<T&> { static const bool value = true; };
+template<typename T> is_ref<T> kind(T &&);
+
+int i;
+static_assert(decltype(kind(i))::value, "lvalue");
+static_assert(!decltype(kind(static_cast<int &&>(i)))::value, "xvalue");
+static_assert(!decltype(kind(0))::value, "prvalue");
+static_assert(decltype(kind(i))::value, "lvalue again");
+
+// CHECK: {{[1-9][0-9]*}} of {{[1-9][0-9]*}} template argument deductions found in the cache
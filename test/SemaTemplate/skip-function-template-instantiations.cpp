@@ -0,0 +1,37 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify %s -DINSTANTIATE
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify %s -skip-function-template-instantiations
+// RUN: not %clang_cc1 -std=c++11 -emit-llvm -o - %s -skip-function-template-instantiations 2>&1 | FileCheck -check-prefix=CODEGEN %s
+
+// CODEGEN: error: invalid argument '-skip-function-template-instantiations' not allowed with '-emit-llvm'
+
+#ifndef INSTANTIATE
+// expected-no-diagnostics
+#endif
+
+#ifdef INSTANTIATE
+// expected-error@+2 {{member reference base type 'int' is not a structure or union}}
+#endif
+template<typename T> void f(T t) { t.missing(); }
+
+template<typename T> struct S {
+#ifdef INSTANTIATE
+  // expected-error@+2 {{type 'int' cannot be used prior to '::' because it has no members}}
+#endif
+  void g() { T::missing(); }
+};
+
+void use() {
+#ifdef INSTANTIATE
+  // expected-note@+2 {{in instantiation of function template specialization 'f<int>' requested here}}
+#endif
+  f(0);
+  S<int> s;
+#ifdef INSTANTIATE
+  // expected-note@+2 {{in instantiation of member function 'S<int>::g' requested here}}
+#endif
+  s.g();
+}
+
+// Constant evaluation still needs the bodies of constexpr functions.
+template<typename T> constexpr T twice(T t) { return t + t; }
+static_assert(twice(21) == 42, "");
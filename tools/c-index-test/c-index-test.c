@@ -1764,6 +1764,8 @@ int perform_code_completion(int argc, const char **argv, int timing_only) {
     completionOptions |= CXCodeComplete_IncludeCodePatterns;
   if (getenv("CINDEXTEST_COMPLETION_BRIEF_COMMENTS"))
     completionOptions |= CXCodeComplete_IncludeBriefComments;
+  if (getenv("CINDEXTEST_COMPLETION_FILTER_CACHED"))
+    completionOptions |= CXCodeComplete_FilterCachedResults;
   
   if (timing_only)
     input += strlen("-code-completion-timing=");
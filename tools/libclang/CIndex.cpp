@@ -70,6 +70,7 @@ CXTranslationUnit cxtu::MakeCXTranslationUnit(CIndexer *CIdx, ASTUnit *AU) {
   D->OverridenCursorsPool = createOverridenCXCursorsPool();
   D->FormatContext = 0;
   D->FormatInMemoryUniqueId = 0;
+  D->CompletionSession = 0;
   return D;
 }
 
@@ -2823,6 +2824,7 @@ void clang_disposeTranslationUnit(CXTranslationUnit CTUnit) {
     delete static_cast<CXDiagnosticSetImpl *>(CTUnit->Diagnostics);
     disposeOverridenCXCursorsPool(CTUnit->OverridenCursorsPool);
     delete CTUnit->FormatContext;
+    cxtu::resetCompletionSession(CTUnit);
     delete CTUnit;
   }
 }
@@ -2850,6 +2852,10 @@ static void clang_reparseTranslationUnit_Impl(void *UserData) {
   delete static_cast<CXDiagnosticSetImpl*>(TU->Diagnostics);
   TU->Diagnostics = 0;
 
+  // Files other than the unsaved ones may have changed, so the results of
+  // earlier code completions can no longer be reused.
+  cxtu::resetCompletionSession(TU);
+
   unsigned num_unsaved_files = RTUI->num_unsaved_files;
   struct CXUnsavedFile *unsaved_files = RTUI->unsaved_files;
   unsigned options = RTUI->options;
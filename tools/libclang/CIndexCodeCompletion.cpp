@@ -21,12 +21,14 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/Type.h"
+#include "clang/Basic/CharInfo.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Atomic.h"
@@ -35,9 +37,11 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 
 #ifdef UDP_CODE_COMPLETION_LOGGER
@@ -352,6 +356,158 @@ AllocatedCXCodeCompleteResults::~AllocatedCXCodeCompleteResults() {
   
 } // end extern "C"
 
+namespace {
+
+/// \brief The results of the most recent code completion in a translation
+/// unit that was performed with \c CXCodeComplete_FilterCachedResults.
+///
+/// A completion's results depend only on the text before the completion
+/// point, so while a client types an identifier after a fixed completion
+/// point, each request can be answered by filtering these results instead of
+/// reparsing the main file.
+struct CompletionSession {
+  /// \brief A hash of everything the results depend on.
+  size_t Key;
+
+  /// \brief All of the results, best first.
+  std::vector<CXCompletionResult> Results;
+
+  IntrusiveRefCntPtr<clang::GlobalCodeCompletionAllocator>
+    CachedCompletionAllocator;
+  IntrusiveRefCntPtr<clang::GlobalCodeCompletionAllocator>
+    CodeCompletionAllocator;
+
+  enum clang::CodeCompletionContext::Kind ContextKind;
+  unsigned long long Contexts;
+  enum CXCursorKind ContainerKind;
+  std::string ContainerUSR;
+  unsigned ContainerIsIncomplete;
+  std::string Selector;
+};
+
+/// \brief Orders completion results by priority, then by typed text.
+struct OrderCompletionResultsByPriority {
+  bool operator()(const CXCompletionResult &X,
+                  const CXCompletionResult &Y) const {
+    const CodeCompletionString *XS
+      = static_cast<const CodeCompletionString *>(X.CompletionString);
+    const CodeCompletionString *YS
+      = static_cast<const CodeCompletionString *>(Y.CompletionString);
+    if (XS->getPriority() != YS->getPriority())
+      return XS->getPriority() < YS->getPriority();
+    StringRef XText = XS->getTypedText() ? XS->getTypedText() : "";
+    StringRef YText = YS->getTypedText() ? YS->getTypedText() : "";
+    return XText.compare_lower(YText) < 0;
+  }
+};
+
+} // end anonymous namespace
+
+/// \brief Compute the key of a code-completion request for the completion
+/// session, and find the identifier typed after the completion point.
+///
+/// \returns false if the results cannot be kept, because the file being
+/// completed is not one of the unsaved files.
+static bool getCompletionSessionKey(const char *File, unsigned Line,
+                                    unsigned Column,
+                                    struct CXUnsavedFile *UnsavedFiles,
+                                    unsigned NumUnsavedFiles,
+                                    unsigned Options, size_t &Key,
+                                    StringRef &TypedText) {
+  if (!File || !Line || !Column)
+    return false;
+
+  llvm::hash_code Hash = llvm::hash_combine(StringRef(File), Line, Column,
+                                            Options);
+  bool FoundFile = false;
+  for (unsigned I = 0; I != NumUnsavedFiles; ++I) {
+    StringRef Name(UnsavedFiles[I].Filename);
+    StringRef Contents(UnsavedFiles[I].Contents, UnsavedFiles[I].Length);
+    if (!FoundFile && Name == File) {
+      size_t Offset = 0;
+      for (unsigned L = 1; L != Line; ++L) {
+        Offset = Contents.find('\n', Offset);
+        if (Offset == StringRef::npos)
+          return false;
+        ++Offset;
+      }
+      Offset += Column - 1;
+      if (Offset > Contents.size())
+        return false;
+
+      // Only the text before the completion point determines the results.
+      size_t End = Offset;
+      while (End != Contents.size() && isIdentifierBody(Contents[End]))
+        ++End;
+      TypedText = Contents.slice(Offset, End);
+      Contents = Contents.substr(0, Offset);
+      FoundFile = true;
+    }
+    Hash = llvm::hash_combine(Hash, Name, Contents);
+  }
+
+  Key = Hash;
+  return FoundFile;
+}
+
+/// \brief Keep the results of a completion in the translation unit's
+/// completion session.
+static void saveCompletionSession(CXTranslationUnit TU, size_t Key,
+                                  const AllocatedCXCodeCompleteResults &From) {
+  CompletionSession *Session
+    = static_cast<CompletionSession *>(TU->CompletionSession);
+  if (!Session)
+    TU->CompletionSession = Session = new CompletionSession;
+
+  Session->Key = Key;
+  Session->Results.assign(From.Results, From.Results + From.NumResults);
+  std::stable_sort(Session->Results.begin(), Session->Results.end(),
+                   OrderCompletionResultsByPriority());
+  Session->CachedCompletionAllocator = From.CachedCompletionAllocator;
+  Session->CodeCompletionAllocator = From.CodeCompletionAllocator;
+  Session->ContextKind = From.ContextKind;
+  Session->Contexts = From.Contexts;
+  Session->ContainerKind = From.ContainerKind;
+  Session->ContainerUSR = From.ContainerUSR;
+  Session->ContainerIsIncomplete = From.ContainerIsIncomplete;
+  Session->Selector = From.Selector;
+}
+
+/// \brief Replace the results in \p Results by those of the completion
+/// session whose typed text starts with \p TypedText, ignoring case.
+static void filterCompletionSession(const CompletionSession &Session,
+                                    StringRef TypedText,
+                                    AllocatedCXCodeCompleteResults &Results) {
+  SmallVector<CXCompletionResult, 64> Kept;
+  for (unsigned I = 0, N = Session.Results.size(); I != N; ++I) {
+    const CodeCompletionString *CCS = static_cast<const CodeCompletionString *>(
+                                          Session.Results[I].CompletionString);
+    StringRef Text = CCS->getTypedText() ? CCS->getTypedText() : "";
+    if (Text.size() >= TypedText.size() &&
+        Text.substr(0, TypedText.size()).equals_lower(TypedText))
+      Kept.push_back(Session.Results[I]);
+  }
+
+  delete [] Results.Results;
+  Results.Results = new CXCompletionResult [Kept.size()];
+  Results.NumResults = Kept.size();
+  std::copy(Kept.begin(), Kept.end(), Results.Results);
+
+  Results.CachedCompletionAllocator = Session.CachedCompletionAllocator;
+  Results.CodeCompletionAllocator = Session.CodeCompletionAllocator;
+  Results.ContextKind = Session.ContextKind;
+  Results.Contexts = Session.Contexts;
+  Results.ContainerKind = Session.ContainerKind;
+  Results.ContainerUSR = Session.ContainerUSR;
+  Results.ContainerIsIncomplete = Session.ContainerIsIncomplete;
+  Results.Selector = Session.Selector;
+}
+
+void cxtu::resetCompletionSession(CXTranslationUnit TU) {
+  delete static_cast<CompletionSession *>(TU->CompletionSession);
+  TU->CompletionSession = 0;
+}
+
 static unsigned long long getContextsForContextKind(
                                           enum CodeCompletionContext::Kind kind, 
                                                     Sema &S) {
@@ -691,6 +847,26 @@ void clang_codeCompleteAt_Impl(void *UserData) {
 
   ASTUnit::ConcurrencyCheck Check(*AST);
 
+  // If this request continues the previous one, answer it from the results
+  // kept in the completion session.
+  size_t SessionKey = 0;
+  StringRef TypedText;
+  bool UseSession = (options & CXCodeComplete_FilterCachedResults) &&
+    getCompletionSessionKey(complete_filename, complete_line, complete_column,
+                            unsaved_files, num_unsaved_files, options,
+                            SessionKey, TypedText);
+  if (UseSession && TU->CompletionSession &&
+      static_cast<CompletionSession *>(TU->CompletionSession)->Key
+        == SessionKey) {
+    AllocatedCXCodeCompleteResults *Results
+      = new AllocatedCXCodeCompleteResults(AST->getFileSystemOpts());
+    filterCompletionSession(
+        *static_cast<CompletionSession *>(TU->CompletionSession), TypedText,
+        *Results);
+    CCAI->result = Results;
+    return;
+  }
+
   // Perform the remapping of source files.
   SmallVector<ASTUnit::RemappedFile, 4> RemappedFiles;
   for (unsigned I = 0; I != num_unsaved_files; ++I) {
@@ -711,21 +887,23 @@ void clang_codeCompleteAt_Impl(void *UserData) {
   Results->Results = 0;
   Results->NumResults = 0;
   
-  // Create a code-completion consumer to capture the results.
-  CodeCompleteOptions Opts;
-  Opts.IncludeBriefComments = IncludeBriefComments;
-  CaptureCompletionResults Capture(Opts, *Results, &TU);
-
-  // Perform completion.
-  AST->CodeComplete(complete_filename, complete_line, complete_column,
-                    RemappedFiles.data(), RemappedFiles.size(), 
-                    (options & CXCodeComplete_IncludeMacros),
-                    (options & CXCodeComplete_IncludeCodePatterns),
-                    IncludeBriefComments,
-                    Capture,
-                    *Results->Diag, Results->LangOpts, *Results->SourceMgr,
-                    *Results->FileMgr, Results->Diagnostics,
-                    Results->TemporaryBuffers);
+  {
+    // Create a code-completion consumer to capture the results.
+    CodeCompleteOptions Opts;
+    Opts.IncludeBriefComments = IncludeBriefComments;
+    CaptureCompletionResults Capture(Opts, *Results, &TU);
+
+    // Perform completion.
+    AST->CodeComplete(complete_filename, complete_line, complete_column,
+                      RemappedFiles.data(), RemappedFiles.size(), 
+                      (options & CXCodeComplete_IncludeMacros),
+                      (options & CXCodeComplete_IncludeCodePatterns),
+                      IncludeBriefComments,
+                      Capture,
+                      *Results->Diag, Results->LangOpts, *Results->SourceMgr,
+                      *Results->FileMgr, Results->Diagnostics,
+                      Results->TemporaryBuffers);
+  }
   
   // Keep a reference to the allocator used for cached global completions, so
   // that we can be sure that the memory used by our code completion strings
@@ -733,6 +911,13 @@ void clang_codeCompleteAt_Impl(void *UserData) {
   // results are still active).
   Results->CachedCompletionAllocator = AST->getCachedCompletionAllocator();
 
+  if (UseSession) {
+    saveCompletionSession(TU, SessionKey, *Results);
+    filterCompletionSession(
+        *static_cast<CompletionSession *>(TU->CompletionSession), TypedText,
+        *Results);
+  }
+
   
 
 #ifdef UDP_CODE_COMPLETION_LOGGER
@@ -31,6 +31,7 @@ struct CXTranslationUnitImpl {
   void *OverridenCursorsPool;
   clang::SimpleFormatContext *FormatContext;
   unsigned FormatInMemoryUniqueId;
+  void *CompletionSession;
 };
 
 namespace clang {
@@ -42,6 +43,9 @@ static inline ASTUnit *getASTUnit(CXTranslationUnit TU) {
   return TU->TheASTUnit;
 }
 
+/// \brief Discard the results kept for filtering subsequent code completions.
+void resetCompletionSession(CXTranslationUnit TU);
+
 class CXTUOwner {
   CXTranslationUnitImpl *TU;
   
@@ -620,8 +620,13 @@ static void clang_indexSourceFile_Impl(void *UserData) {
   // revisited.
   bool SkipBodies = (index_options & CXIndexOpt_SkipParsedBodiesInSession) &&
       CInvok->getLangOpts()->CPlusPlus;
-  if (SkipBodies)
+  if (SkipBodies) {
     CInvok->getFrontendOpts().SkipFunctionBodies = true;
+    // Instantiated bodies are only looked at when indexing implicit template
+    // instantiations.
+    if (!(index_options & CXIndexOpt_IndexImplicitTemplateInstantiations))
+      CInvok->getFrontendOpts().SkipFunctionTemplateInstantiations = true;
+  }
 
   OwningPtr<IndexingFrontendAction> IndexAction;
   IndexAction.reset(new IndexingFrontendAction(client_data, CB,
@@ -0,0 +1,90 @@
+//===- unittests/AST/BaseClassCacheTest.cpp --- Base class cache tests ----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains tests for ASTContext::getAllBaseClasses() and the
+// CXXRecordDecl queries that use it.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Tooling/Tooling.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <functional>
+
+using namespace clang;
+using namespace ast_matchers;
+using namespace tooling;
+
+namespace {
+
+class BaseClassMatch : public MatchFinder::MatchCallback {
+public:
+  bool Ran;
+
+  BaseClassMatch() : Ran(false) {}
+
+  virtual void run(const MatchFinder::MatchResult &Result) {
+    const CXXRecordDecl *D = Result.Nodes.getDeclAs<CXXRecordDecl>("id");
+    if (!D || D->isInjectedClassName())
+      return;
+    ASTContext &Context = *Result.Context;
+    Ran = true;
+
+    ArrayRef<const CXXRecordDecl*> Bases;
+    ASSERT_TRUE(Context.getAllBaseClasses(D, Bases));
+    ASSERT_EQ(4U, Bases.size());
+    EXPECT_TRUE(std::adjacent_find(Bases.begin(), Bases.end(),
+                  std::greater_equal<const CXXRecordDecl*>()) == Bases.end());
+    EXPECT_TRUE(std::binary_search(Bases.begin(), Bases.end(),
+                                   find(Context, "A")));
+    EXPECT_TRUE(std::binary_search(Bases.begin(), Bases.end(),
+                                   find(Context, "V")));
+
+    // The second query is answered from the cache.
+    ArrayRef<const CXXRecordDecl*> Again;
+    ASSERT_TRUE(Context.getAllBaseClasses(D, Again));
+    EXPECT_EQ(Bases.data(), Again.data());
+
+    EXPECT_TRUE(D->isDerivedFrom(find(Context, "A")));
+    EXPECT_TRUE(D->isDerivedFrom(find(Context, "C")));
+    EXPECT_FALSE(D->isDerivedFrom(find(Context, "E")));
+    EXPECT_FALSE(D->isDerivedFrom(D));
+    EXPECT_TRUE(D->isVirtuallyDerivedFrom(find(Context, "V")));
+    EXPECT_FALSE(D->isVirtuallyDerivedFrom(find(Context, "A")));
+
+    // Incomplete classes are not cached.
+    EXPECT_FALSE(Context.getAllBaseClasses(find(Context, "Incomplete"),
+                                           Bases));
+  }
+
+private:
+  static const CXXRecordDecl *find(ASTContext &Context, StringRef Name) {
+    DeclContext::lookup_result R =
+      Context.getTranslationUnitDecl()->lookup(&Context.Idents.get(Name));
+    return R.empty() ? 0 : dyn_cast<CXXRecordDecl>(R.front());
+  }
+};
+
+} // end anonymous namespace
+
+TEST(BaseClassCache, TransitiveBases) {
+  BaseClassMatch Match;
+  MatchFinder Finder;
+  Finder.addMatcher(recordDecl(hasName("D")).bind("id"), &Match);
+  OwningPtr<FrontendActionFactory> Factory(newFrontendActionFactory(&Finder));
+
+  ASSERT_TRUE(runToolOnCode(Factory->create(),
+    "struct A {}; struct B : A {}; struct V {};"
+    "struct C : B, virtual V {}; struct D : C {}; struct E {};"
+    "struct Incomplete;"));
+  EXPECT_TRUE(Match.Ran);
+}
@@ -0,0 +1,103 @@
+//===- unittests/AST/MangledNameTest.cpp --- Mangled name cache tests -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains tests for ASTContext::getMangledName().
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTContext.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Tooling/Tooling.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+using namespace ast_matchers;
+using namespace tooling;
+
+namespace {
+
+class MangleMatch : public MatchFinder::MatchCallback {
+  std::string Mangled;
+  bool Stable;
+
+public:
+  MangleMatch() : Stable(false) {}
+
+  virtual void run(const MatchFinder::MatchResult &Result) {
+    const NamedDecl *D = Result.Nodes.getDeclAs<NamedDecl>("id");
+    if (!D)
+      return;
+
+    StringRef First = Result.Context->getMangledName(D);
+    StringRef Second = Result.Context->getMangledName(D);
+    Mangled = First;
+    // The second lookup must hand back the interned string, not a copy.
+    Stable = First.data() == Second.data();
+  }
+
+  StringRef getMangled() const { return Mangled; }
+  bool isStable() const { return Stable; }
+};
+
+::testing::AssertionResult MangledNameMatches(StringRef Code,
+                                              const DeclarationMatcher &Match,
+                                              StringRef Expected) {
+  MangleMatch Mangler;
+  MatchFinder Finder;
+  Finder.addMatcher(Match, &Mangler);
+  OwningPtr<FrontendActionFactory> Factory(newFrontendActionFactory(&Finder));
+
+  std::vector<std::string> Args;
+  Args.push_back("-target");
+  Args.push_back("x86_64-unknown-linux-gnu");
+  if (!runToolOnCodeWithArgs(Factory->create(), Code, Args, "input.cc"))
+    return testing::AssertionFailure() << "Parsing error in \"" << Code << "\"";
+
+  if (Mangler.getMangled() != Expected)
+    return testing::AssertionFailure()
+      << "Expected \"" << Expected << "\", got \"" << Mangler.getMangled()
+      << "\"";
+
+  if (!Mangler.isStable())
+    return testing::AssertionFailure() << "Mangled name was not cached";
+
+  return testing::AssertionSuccess();
+}
+
+} // end anonymous namespace
+
+TEST(MangledName, Function) {
+  ASSERT_TRUE(MangledNameMatches(
+    "namespace N { void A(int, char); }",
+    functionDecl(hasName("A")).bind("id"),
+    "_ZN1N1AEic"));
+}
+
+TEST(MangledName, ExternC) {
+  ASSERT_TRUE(MangledNameMatches(
+    "extern \"C\" void A(int);",
+    functionDecl(hasName("A")).bind("id"),
+    "A"));
+}
+
+TEST(MangledName, TemplateSpecialization) {
+  ASSERT_TRUE(MangledNameMatches(
+    "template<typename T> struct Z {};"
+    "template<typename T> void A(Z<T>, Z<T>) {}"
+    "template void A<int>(Z<int>, Z<int>);",
+    functionDecl(hasName("A"), isTemplateInstantiation()).bind("id"),
+    "_Z1AIiEv1ZIT_ES2_"));
+}
+
+TEST(MangledName, Variable) {
+  ASSERT_TRUE(MangledNameMatches(
+    "namespace N { int A; }",
+    varDecl(hasName("A")).bind("id"),
+    "_ZN1N1AE"));
+}
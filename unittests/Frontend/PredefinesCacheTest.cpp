@@ -0,0 +1,63 @@
+//===- unittests/Frontend/PredefinesCacheTest.cpp - Predefines cache tests ===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/CompilerInvocation.h"
+#include "clang/Frontend/FrontendActions.h"
+#include "clang/Frontend/Utils.h"
+#include "clang/Lex/Preprocessor.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace clang;
+
+namespace {
+
+class RecordPredefinesAction : public PreprocessOnlyAction {
+public:
+  std::string Predefines;
+
+protected:
+  virtual void ExecuteAction() {
+    Predefines = getCompilerInstance().getPreprocessor().getPredefines();
+    PreprocessOnlyAction::ExecuteAction();
+  }
+};
+
+static std::string getPredefines() {
+  CompilerInvocation *invocation = new CompilerInvocation;
+  invocation->getPreprocessorOpts().addRemappedFile(
+    "test.c", MemoryBuffer::getMemBuffer("int x;"));
+  invocation->getFrontendOpts().Inputs.push_back(FrontendInputFile("test.c",
+                                                                   IK_C));
+  invocation->getFrontendOpts().ProgramAction = frontend::RunPreprocessorOnly;
+  // A configuration that no other test in this process uses.
+  invocation->getTargetOpts().Triple = "x86_64-unknown-freebsd10.0";
+  CompilerInstance compiler;
+  compiler.setInvocation(invocation);
+  compiler.createDiagnostics();
+
+  RecordPredefinesAction action;
+  EXPECT_TRUE(compiler.ExecuteAction(action));
+  return action.Predefines;
+}
+
+TEST(PredefinesCache, ReusedBySecondCompilation) {
+  unsigned HitsBefore = getNumCachedPredefinesHits();
+  std::string First = getPredefines();
+  EXPECT_EQ(HitsBefore, getNumCachedPredefinesHits());
+
+  std::string Second = getPredefines();
+  EXPECT_EQ(HitsBefore + 1, getNumCachedPredefinesHits());
+  EXPECT_NE(std::string::npos, First.find("#define __FreeBSD__ 10"));
+  EXPECT_EQ(First, Second);
+}
+
+} // anonymous namespace
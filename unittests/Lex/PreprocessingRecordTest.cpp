@@ -0,0 +1,119 @@
+//===- unittests/Lex/PreprocessingRecordTest.cpp - PP record tests --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/PreprocessingRecord.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TargetOptions.h"
+#include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/HeaderSearchOptions.h"
+#include "clang/Lex/ModuleLoader.h"
+#include "clang/Lex/Preprocessor.h"
+#include "clang/Lex/PreprocessorOptions.h"
+#include "llvm/Config/config.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace clang;
+
+namespace {
+
+// The test fixture.
+class PreprocessingRecordTest : public ::testing::Test {
+protected:
+  PreprocessingRecordTest()
+    : FileMgr(FileMgrOpts),
+      DiagID(new DiagnosticIDs()),
+      Diags(DiagID, new DiagnosticOptions, new IgnoringDiagConsumer()),
+      SourceMgr(Diags, FileMgr),
+      TargetOpts(new TargetOptions)
+  {
+    TargetOpts->Triple = "x86_64-apple-darwin11.1.0";
+    Target = TargetInfo::CreateTargetInfo(Diags, &*TargetOpts);
+  }
+
+  FileSystemOptions FileMgrOpts;
+  FileManager FileMgr;
+  IntrusiveRefCntPtr<DiagnosticIDs> DiagID;
+  DiagnosticsEngine Diags;
+  SourceManager SourceMgr;
+  LangOptions LangOpts;
+  IntrusiveRefCntPtr<TargetOptions> TargetOpts;
+  IntrusiveRefCntPtr<TargetInfo> Target;
+};
+
+class VoidModuleLoader : public ModuleLoader {
+  virtual ModuleLoadResult loadModule(SourceLocation ImportLoc,
+                                      ModuleIdPath Path,
+                                      Module::NameVisibilityKind Visibility,
+                                      bool IsInclusionDirective) {
+    return ModuleLoadResult();
+  }
+
+  virtual void makeModuleVisible(Module *Mod,
+                                 Module::NameVisibilityKind Visibility,
+                                 SourceLocation ImportLoc) { }
+};
+
+TEST_F(PreprocessingRecordTest, MacroExpansionsCreatedOnDemand) {
+  const unsigned NumExpansions = 1000;
+  std::string source = "#define M 1\n";
+  for (unsigned I = 0; I != NumExpansions; ++I)
+    source += "M\n";
+
+  MemoryBuffer *buf = MemoryBuffer::getMemBufferCopy(source);
+  SourceMgr.createMainFileIDForMemBuffer(buf);
+
+  VoidModuleLoader ModLoader;
+  HeaderSearch HeaderInfo(new HeaderSearchOptions, FileMgr, Diags, LangOpts,
+                          Target.getPtr());
+  Preprocessor PP(new PreprocessorOptions(), Diags, LangOpts,Target.getPtr(),
+                  SourceMgr, HeaderInfo, ModLoader,
+                  /*IILookup =*/ 0,
+                  /*OwnsHeaderSearch =*/false,
+                  /*DelayInitialization =*/ false);
+  PP.createPreprocessingRecord();
+  PP.EnterMainSourceFile();
+
+  Token tok;
+  do {
+    PP.Lex(tok);
+  } while (tok.isNot(tok::eof));
+
+  // The expansions are recorded without allocating an entity for each.
+  PreprocessingRecord &PPRec = *PP.getPreprocessingRecord();
+  size_t MemoryBefore = PPRec.getTotalMemory();
+
+  PreprocessingRecord::iterator I = PPRec.local_begin();
+  ASSERT_TRUE(I != PPRec.local_end());
+  MacroDefinition *Def = dyn_cast<MacroDefinition>(*I);
+  ASSERT_TRUE(Def != 0);
+  EXPECT_TRUE(Def->getName()->isStr("M"));
+
+  unsigned NumSeen = 0;
+  for (++I; I != PPRec.local_end(); ++I, ++NumSeen) {
+    MacroExpansion *Expansion = dyn_cast<MacroExpansion>(*I);
+    ASSERT_TRUE(Expansion != 0);
+    EXPECT_EQ(Def, Expansion->getDefinition());
+    EXPECT_EQ(Expansion, *I);
+    EXPECT_EQ(NumSeen + 2,
+              SourceMgr.getPresumedLineNumber(Expansion->getLocStart()));
+  }
+  EXPECT_EQ(NumExpansions, NumSeen);
+
+  // Asking for them creates the entities.
+  EXPECT_LE(MemoryBefore + NumExpansions * sizeof(MacroExpansion),
+            PPRec.getTotalMemory());
+}
+
+} // anonymous namespace